@@ -0,0 +1,350 @@
+#include "DictionaryIndex.h"
+#include "GraphBuilder.h"
+#include "PatternIndex.h"
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * @brief Baseline benchmarks of dictionary loading, graph construction and queries.
+ *
+ * Usage: engine_bench [--dictionary FILE] [--sizes N,N,...] [--lengths L,L,...]
+ *                     [--queries N] [--max-graph-words N] [--output FILE]
+ *
+ * Every benchmark runs on the shipped dictionary (default src/dictionary.txt), once per
+ * word length it contains, and on synthetic dictionaries of each requested size and
+ * length (default 1k, 10k, 100k and 1M words of lengths 6 and 8). Synthetic words are
+ * drawn with English letter frequencies, so their graphs cluster like real ones.
+ *
+ * Measured operations:
+ * - loadDictionary: GraphBuilder::loadDictionary on a file of the dataset's words (ms).
+ * - DictionaryIndex::load: reading and indexing the same file (ms).
+ * - DictionaryIndex::contains: membership of the dataset's words and as many misses (ns per lookup).
+ * - buildPatternMap: sorting the words and building the pattern index (ms).
+ * - buildGraph: GraphBuilder::buildGraph, the std::set based Graph (ms).
+ * - buildCompactGraph: GraphBuilder::buildCompactGraph, the graph Solver uses (ms).
+ * - GraphBuilder::removeWord, GraphBuilder::addWord: editing the words back out and in (ns per edit).
+ * - Graph::shortestPath, Solver::findShortestPath: random reachable pairs (ns per query).
+ * - Solver::getHint: a new target per query, and the same target for all (ns per query).
+ * - validateMove: the play tab's checks on a mix of legal and illegal moves (ns per move).
+ *
+ * Builds are repeated until they have run for a quarter of a second; queries are timed
+ * one by one. Graph-based benchmarks are skipped above --max-graph-words (default
+ * 100000), where the std::set graph needs gigabytes, and so are measurements that end
+ * up without samples. Results are written as JSON to standard output or to --output.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Settings {
+    std::string dictionaryPath = "src/dictionary.txt";
+    std::vector<std::size_t> sizes = { 1000, 10000, 100000, 1000000 };
+    std::vector<std::size_t> lengths = { 6, 8 };
+    std::size_t queryCount = 1000;
+    std::size_t maxGraphWords = 100000;
+    std::string outputPath;
+};
+
+/**
+ * @brief Samples of one operation on one dataset.
+ */
+struct Measurement {
+    std::string dataset;
+    std::size_t wordLength;
+    std::size_t wordCount;
+    std::string name;
+    std::string unit;
+    std::vector<double> samples;
+};
+
+double elapsed(Clock::time_point started, double unitsPerSecond) {
+    return std::chrono::duration<double>(Clock::now() - started).count() * unitsPerSecond;
+}
+
+/**
+ * @brief Runs fn repeatedly for at least a quarter of a second and returns each run in ms.
+ */
+template <typename Fn>
+std::vector<double> timeRepeated(Fn&& fn) {
+    std::vector<double> samples;
+    const Clock::time_point until = Clock::now() + std::chrono::milliseconds(250);
+    do {
+        auto started = Clock::now();
+        fn();
+        samples.push_back(elapsed(started, 1e3));
+    } while (Clock::now() < until && samples.size() < 1000);
+    return samples;
+}
+
+/**
+ * @brief Calls fn once per item and returns each call in ns.
+ */
+template <typename Item, typename Fn>
+std::vector<double> timeEach(const std::vector<Item>& items, Fn&& fn) {
+    std::vector<double> samples;
+    samples.reserve(items.size());
+    for (const Item& item : items) {
+        auto started = Clock::now();
+        fn(item);
+        samples.push_back(elapsed(started, 1e9));
+    }
+    return samples;
+}
+
+/**
+ * @brief Generates distinct upper-case words with English letter frequencies.
+ *
+ * @return The words, or an empty vector if the length cannot hold that many words comfortably.
+ */
+std::vector<std::string> syntheticWords(std::size_t count, std::size_t length) {
+    static const double frequencies[26] = { 8.2, 1.5, 2.8, 4.3, 12.7, 2.2, 2.0, 6.1, 7.0, 0.15, 0.77, 4.0, 2.4,
+        6.7, 7.5, 1.9, 0.1, 6.0, 6.3, 9.1, 2.8, 0.98, 2.4, 0.15, 2.0, 0.07 };
+    // Skewed letters make collisions frequent well before 26^length: the effective
+    // alphabet is the perplexity of the distribution. Stay below half of that space.
+    double total = 0;
+    for (double f : frequencies) total += f;
+    double entropy = 0;
+    for (double f : frequencies) entropy -= f / total * std::log2(f / total);
+    if (count > std::exp2(entropy * length) / 2) return {};
+
+    std::mt19937 generator(static_cast<std::uint32_t>(count * 31 + length));
+    std::discrete_distribution<int> letter(std::begin(frequencies), std::end(frequencies));
+    std::unordered_set<std::string> unique;
+    std::vector<std::string> words;
+    words.reserve(count);
+    std::string word(length, 'A');
+    while (words.size() < count) {
+        for (char& c : word) c = static_cast<char>('A' + letter(generator));
+        if (unique.insert(word).second) words.push_back(word);
+    }
+    return words;
+}
+
+/**
+ * @brief Runs every benchmark on one set of words of the same length.
+ */
+void benchmarkDataset(const std::string& dataset, const std::vector<std::string>& words,
+    const Settings& settings, std::vector<Measurement>& results) {
+    const std::size_t length = words.front().size();
+    auto record = [&](const std::string& name, const std::string& unit, std::vector<double> samples) {
+        std::cerr << "  " << dataset << " length " << length << ", " << words.size() << " words: " << name;
+        // An empty measurement has no minimum, median or maximum to report.
+        if (samples.empty()) {
+            std::cerr << " skipped, no samples" << std::endl;
+            return;
+        }
+        results.push_back({ dataset, length, words.size(), name, unit, std::move(samples) });
+        std::cerr << std::endl;
+    };
+
+    const std::string dictionaryFile = "engine_bench_" + std::to_string(length) + "_"
+        + std::to_string(words.size()) + ".tmp";
+    {
+        std::ofstream out(dictionaryFile);
+        for (const std::string& word : words) out << word << '\n';
+    }
+    record("loadDictionary", "ms", timeRepeated([&]() { GraphBuilder::loadDictionary(dictionaryFile, length); }));
+    std::shared_ptr<const DictionaryIndex> dictionary;
+    record("DictionaryIndex::load", "ms", timeRepeated([&]() { dictionary = DictionaryIndex::load(dictionaryFile); }));
+    std::remove(dictionaryFile.c_str());
+
+    std::vector<std::string> lookups(words.begin(), words.begin() + std::min<std::size_t>(words.size(), settings.queryCount));
+    for (std::size_t i = 0, count = lookups.size(); i < count; ++i) {
+        std::string miss = lookups[i];
+        miss.back() = miss.back() == 'Z' ? 'A' : static_cast<char>(miss.back() + 1);
+        lookups.push_back(miss);
+    }
+    record("DictionaryIndex::contains", "ns", timeEach(lookups, [&](const std::string& word) {
+        dictionary->contains(word);
+    }));
+
+    record("buildPatternMap", "ms", timeRepeated([&]() {
+        std::vector<std::string_view> sorted(words.begin(), words.end());
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+        PatternIndex index;
+        index.build(sorted);
+    }));
+
+    GraphBuilder builder;
+    CompactGraph compact;
+    record("buildCompactGraph", "ms", timeRepeated([&]() { compact = builder.buildCompactGraph(words); }));
+    Solver solver(compact);
+
+    std::mt19937 generator(7);
+    std::vector<std::pair<std::string, std::string>> pairs;
+    for (std::size_t i = 0; i < settings.queryCount; ++i) {
+        auto pair = solver.sampleReachablePair(generator);
+        if (pair.first.empty()) break;
+        pairs.push_back(pair);
+    }
+
+    const bool withGraph = words.size() <= settings.maxGraphWords;
+    if (withGraph) {
+        Graph<std::string> graph;
+        record("buildGraph", "ms", timeRepeated([&]() { graph = builder.buildGraph(words); }));
+
+        std::vector<std::string> edited(words.begin(), words.begin() + std::min<std::size_t>(words.size(), settings.queryCount));
+        GraphBuilder editor;
+        editor.beginEditing(words);
+        record("GraphBuilder::removeWord", "ns", timeEach(edited, [&](const std::string& word) { editor.removeWord(word); }));
+        record("GraphBuilder::addWord", "ns", timeEach(edited, [&](const std::string& word) { editor.addWord(word); }));
+        if (!pairs.empty()) {
+            record("Graph::shortestPath", "ns", timeEach(pairs, [&](const std::pair<std::string, std::string>& pair) {
+                graph.shortestPath(pair.first, pair.second);
+            }));
+        }
+    }
+    if (pairs.empty()) return;
+
+    record("Solver::findShortestPath", "ns", timeEach(pairs, [&](const std::pair<std::string, std::string>& pair) {
+        solver.findShortestPath(pair.first, pair.second);
+    }));
+    record("Solver::getHint (new target)", "ns", timeEach(pairs, [&](const std::pair<std::string, std::string>& pair) {
+        solver.getHint(pair.first, pair.second);
+    }));
+    const std::string fixedTarget = pairs.front().second;
+    std::vector<std::string> sameComponent;
+    for (const auto& pair : pairs) {
+        if (solver.isReachable(pair.first, fixedTarget)) sameComponent.push_back(pair.first);
+    }
+    solver.getHint(pairs.front().first, fixedTarget);
+    record("Solver::getHint (same target)", "ns", timeEach(sameComponent, [&](const std::string& word) {
+        solver.getHint(word, fixedTarget);
+    }));
+
+    // Half of the moves go to a neighbor, the rest to a random word, as typed by a player.
+    std::vector<std::pair<std::string, std::string>> moves;
+    for (const auto& pair : pairs) {
+        const CompactGraph::NodeId from = compact.idOf(pair.first);
+        const std::size_t degree = compact.degree(from);
+        if (moves.size() % 2 == 0 && degree > 0) {
+            moves.emplace_back(pair.first, compact.wordOf(compact.neighborsBegin(from)[generator() % degree]));
+        }
+        else {
+            moves.emplace_back(pair.first, pair.second);
+        }
+    }
+    record("validateMove", "ns", timeEach(moves, [&](const std::pair<std::string, std::string>& move) {
+        if (solver.validateMove(move.first, move.second) == Solver::MoveCheck::Legal) {
+            solver.isOptimalMove(move.first, move.second, fixedTarget);
+        }
+    }));
+}
+
+std::vector<std::size_t> parseList(const std::string& text) {
+    std::vector<std::size_t> values;
+    std::istringstream fields(text);
+    std::string field;
+    while (std::getline(fields, field, ',')) values.push_back(std::strtoul(field.c_str(), nullptr, 10));
+    return values;
+}
+
+/**
+ * @brief Returns the sample at the given fraction of the sorted order. Requires at least one sample.
+ */
+double percentile(std::vector<double> values, double fraction) {
+    std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+void writeJson(std::ostream& out, const std::vector<Measurement>& results) {
+    out << "{\n  \"benchmark\": \"engine_bench\",\n  \"results\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Measurement& m = results[i];
+        double sum = 0;
+        for (double sample : m.samples) sum += sample;
+        out << (i ? "," : "") << "\n    { \"dataset\": \"" << m.dataset << "\", \"wordLength\": " << m.wordLength
+            << ", \"words\": " << m.wordCount << ", \"name\": \"" << m.name << "\", \"unit\": \"" << m.unit
+            << "\", \"samples\": " << m.samples.size()
+            << ", \"min\": " << *std::min_element(m.samples.begin(), m.samples.end())
+            << ", \"median\": " << percentile(m.samples, 0.5)
+            << ", \"mean\": " << sum / m.samples.size()
+            << ", \"p99\": " << percentile(m.samples, 0.99)
+            << ", \"max\": " << *std::max_element(m.samples.begin(), m.samples.end()) << " }";
+    }
+    out << "\n  ]\n}\n";
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Settings settings;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            std::cerr << "Usage: " << argv[0] << " [--dictionary FILE] [--sizes N,N,...] [--lengths L,L,...]"
+                " [--queries N] [--max-graph-words N] [--output FILE]" << std::endl;
+            return 2;
+        }
+        std::string value = argv[++i];
+        if (argument == "--dictionary") settings.dictionaryPath = value;
+        else if (argument == "--sizes") settings.sizes = parseList(value);
+        else if (argument == "--lengths") settings.lengths = parseList(value);
+        else if (argument == "--queries") {
+            settings.queryCount = std::strtoul(value.c_str(), nullptr, 10);
+            if (settings.queryCount == 0) {
+                std::cerr << "--queries must be a positive number" << std::endl;
+                return 2;
+            }
+        }
+        else if (argument == "--max-graph-words") settings.maxGraphWords = std::strtoul(value.c_str(), nullptr, 10);
+        else if (argument == "--output") settings.outputPath = value;
+        else {
+            std::cerr << "Unknown option " << argument << std::endl;
+            return 2;
+        }
+    }
+
+    try {
+        std::vector<Measurement> results;
+
+        std::shared_ptr<const DictionaryIndex> shipped = DictionaryIndex::load(settings.dictionaryPath);
+        for (std::size_t length : shipped->getWordLengths()) {
+            std::vector<std::string> words = shipped->getWords(length);
+            if (words.size() >= 2) benchmarkDataset("shipped", words, settings, results);
+        }
+
+        for (std::size_t length : settings.lengths) {
+            for (std::size_t size : settings.sizes) {
+                std::vector<std::string> words = syntheticWords(size, length);
+                if (words.empty()) {
+                    std::cerr << "  skipping " << size << " words of length " << length << ": too few distinct words" << std::endl;
+                    continue;
+                }
+                benchmarkDataset("synthetic", words, settings, results);
+            }
+        }
+
+        if (settings.outputPath.empty()) {
+            writeJson(std::cout, results);
+        }
+        else {
+            std::ofstream out(settings.outputPath);
+            writeJson(out, results);
+            if (!out) throw std::runtime_error("Could not write " + settings.outputPath);
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
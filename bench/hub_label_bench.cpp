@@ -0,0 +1,118 @@
+#include "DictionaryIndex.h"
+#include "GraphBuilder.h"
+#include "HubLabelIndex.h"
+#include "Solver.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Compares hub label queries with graph searches on one dictionary.
+ *
+ * Usage: hub_label_bench <dictionary.txt> [pairs] [lengths...]
+ *
+ * For each word length the benchmark builds the graph, builds a HubLabelIndex and
+ * reports build time, label size and the mean latency of distance(), path(),
+ * Graph::shortestPath and CompactGraph::bidirectionalShortestPath over the same random
+ * reachable pairs. Every answer is checked against Graph::shortestPath.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double microseconds(Clock::duration elapsed, std::size_t count) {
+    return std::chrono::duration<double, std::micro>(elapsed).count() / std::max<std::size_t>(count, 1);
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    if (argc < 2) {
+        std::cerr << "Usage: " << argv[0] << " <dictionary.txt> [pairs] [lengths...]" << std::endl;
+        return 2;
+    }
+    const std::string dictionaryPath = argv[1];
+    const std::size_t pairCount = argc > 2 ? std::strtoul(argv[2], nullptr, 10) : 1000;
+    std::vector<std::size_t> lengths;
+    for (int i = 3; i < argc; ++i) lengths.push_back(std::strtoul(argv[i], nullptr, 10));
+    if (lengths.empty()) lengths = { 3, 4, 5, 6, 7 };
+
+    try {
+        std::shared_ptr<const DictionaryIndex> dictionary = DictionaryIndex::load(dictionaryPath);
+        for (std::size_t length : lengths) {
+            std::vector<std::string> words = dictionary->getWords(length);
+            GraphBuilder builder;
+            Graph<std::string> graph = builder.buildGraph(words);
+            CompactGraph compact = builder.buildCompactGraph(words);
+            Solver solver(compact);
+
+            auto started = Clock::now();
+            HubLabelIndex index(compact);
+            auto buildTime = Clock::now() - started;
+
+            std::mt19937 generator(42);
+            std::vector<std::pair<CompactGraph::NodeId, CompactGraph::NodeId>> pairs;
+            for (std::size_t i = 0; i < pairCount; ++i) {
+                auto pair = solver.sampleReachablePair(generator);
+                if (pair.first.empty()) break;
+                pairs.emplace_back(compact.idOf(pair.first), compact.idOf(pair.second));
+            }
+
+            std::vector<std::uint32_t> expected;
+            started = Clock::now();
+            for (const auto& pair : pairs) {
+                expected.push_back(static_cast<std::uint32_t>(
+                    graph.shortestPath(compact.wordOf(pair.first), compact.wordOf(pair.second)).size() - 1));
+            }
+            auto graphTime = Clock::now() - started;
+
+            started = Clock::now();
+            std::size_t bidirectionalSum = 0;
+            for (const auto& pair : pairs) {
+                bidirectionalSum += compact.bidirectionalShortestPath(pair.first, pair.second).size() - 1;
+            }
+            auto bidirectionalTime = Clock::now() - started;
+
+            std::size_t mismatches = 0;
+            std::size_t labelSum = 0;
+            started = Clock::now();
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                std::uint32_t distance = index.distance(pairs[i].first, pairs[i].second);
+                labelSum += distance;
+                if (distance != expected[i]) ++mismatches;
+            }
+            auto distanceTime = Clock::now() - started;
+
+            started = Clock::now();
+            for (std::size_t i = 0; i < pairs.size(); ++i) {
+                if (index.path(compact, pairs[i].first, pairs[i].second).size() != expected[i] + 1) ++mismatches;
+            }
+            auto pathTime = Clock::now() - started;
+            if (bidirectionalSum != labelSum) ++mismatches;
+
+            std::cout << "length " << length << ": " << compact.nodeCount() << " words, "
+                << compact.edgeCount() << " edges, " << pairs.size() << " pairs\n"
+                << "  build           " << std::chrono::duration<double, std::milli>(buildTime).count() << " ms\n"
+                << "  labels          " << index.entryCount() << " entries, "
+                << (compact.nodeCount() ? double(index.entryCount()) / compact.nodeCount() : 0.0) << " per word, "
+                << index.memoryUsage() << " bytes\n"
+                << "  distance()      " << microseconds(distanceTime, pairs.size()) << " us/query\n"
+                << "  path()          " << microseconds(pathTime, pairs.size()) << " us/query\n"
+                << "  bidirectional   " << microseconds(bidirectionalTime, pairs.size()) << " us/query\n"
+                << "  Graph BFS       " << microseconds(graphTime, pairs.size()) << " us/query\n"
+                << "  mismatches      " << mismatches << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,119 @@
+#include "BfsEngine.h"
+#include "BitOps.h"
+#include <algorithm>
+
+ BfsEngine::BfsEngine(const CompactGraph& graph) : graph(graph) {
+    parent.resize(graph.nodeCount());
+}
+
+ std::vector<BfsEngine::NodeId> BfsEngine::shortestPath(NodeId start, NodeId end) {
+    if (!run(start, end, false)) return {};
+
+    std::vector<NodeId> path;
+    for (NodeId node = end; node != start; node = parent[node]) {
+        path.push_back(node);
+    }
+    path.push_back(start);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+ std::vector<std::uint32_t> BfsEngine::distancesFrom(NodeId source) {
+    run(source, CompactGraph::InvalidId, true);
+    if (source >= graph.nodeCount()) {
+        return std::vector<std::uint32_t>(graph.nodeCount(), CompactGraph::InvalidId);
+    }
+    return depth;
+}
+
+ bool BfsEngine::run(NodeId start, NodeId stopAt, bool trackDepth) {
+    const std::size_t n = graph.nodeCount();
+    const std::size_t blocks = (n + 63) / 64;
+    stats = Stats();
+    if (start >= n) return false;
+
+    visited.assign(blocks, 0);
+    if (trackDepth) depth.assign(n, CompactGraph::InvalidId);
+
+    markVisited(start);
+    parent[start] = start;
+    if (trackDepth) depth[start] = 0;
+    if (start == stopAt) return true;
+
+    frontier.clear();
+    frontier.push_back(start);
+
+    // Directed edge slots still attached to undiscovered nodes.
+    std::size_t unexploredEdges = graph.edgeCount() * 2 - graph.degree(start);
+    bool bottomUp = false;
+    std::uint32_t level = 0;
+
+    while (!frontier.empty()) {
+        std::size_t frontierEdges = 0;
+        for (NodeId node : frontier) frontierEdges += graph.degree(node);
+
+        if (!bottomUp && frontierEdges > unexploredEdges / Alpha) {
+            bottomUp = true;
+        }
+        else if (bottomUp && frontier.size() < n / Beta) {
+            bottomUp = false;
+        }
+
+        ++level;
+        next.clear();
+        bool found = false;
+        stats.expandedNodes += frontier.size();
+
+        if (!bottomUp) {
+            ++stats.topDownLevels;
+            for (NodeId current : frontier) {
+                for (const NodeId* it = graph.neighborsBegin(current); it != graph.neighborsEnd(current); ++it) {
+                    const NodeId neighbor = *it;
+                    if (isVisited(neighbor)) continue;
+                    markVisited(neighbor);
+                    parent[neighbor] = current;
+                    next.push_back(neighbor);
+                    if (neighbor == stopAt) found = true;
+                }
+            }
+        }
+        else {
+            ++stats.bottomUpLevels;
+            inFrontier.assign(blocks, 0);
+            for (NodeId node : frontier) {
+                inFrontier[node >> 6] |= std::uint64_t(1) << (node & 63);
+            }
+
+            for (std::size_t block = 0; block < blocks; ++block) {
+                std::uint64_t unvisited = ~visited[block];
+                if (block == blocks - 1 && n % 64 != 0) {
+                    unvisited &= (std::uint64_t(1) << (n % 64)) - 1;
+                }
+                while (unvisited) {
+                    const NodeId candidate = static_cast<NodeId>(block * 64 + lowestBitIndex(unvisited));
+                    unvisited &= unvisited - 1;
+
+                    for (const NodeId* it = graph.neighborsBegin(candidate); it != graph.neighborsEnd(candidate); ++it) {
+                        if ((inFrontier[*it >> 6] >> (*it & 63)) & 1u) {
+                            markVisited(candidate);
+                            parent[candidate] = *it;
+                            next.push_back(candidate);
+                            if (candidate == stopAt) found = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        for (NodeId node : next) {
+            unexploredEdges -= graph.degree(node);
+            if (trackDepth) depth[node] = level;
+        }
+        if (found) return true;
+
+        frontier.swap(next);
+    }
+
+    return false;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include "CompactGraph.h"
+#include <cstdint>
+#include <vector>
+
+/**
+ * @class BfsEngine
+ * @brief Direction-optimizing breadth-first search over a CompactGraph.
+ * @ingroup Graph Graph Structures
+ *
+ * Visited and frontier sets are dense bitsets over node IDs, and all scratch buffers are
+ * kept between calls, so repeated searches with the same engine do not allocate.
+ * Each level is expanded either top-down (scan the frontier's neighbors) or bottom-up
+ * (let every unvisited node look for a parent in the frontier), switching between the
+ * two with the frontier-size heuristic of Beamer et al.: go bottom-up once the edges
+ * leaving the frontier outnumber the unexplored edges divided by @c Alpha, and return
+ * to top-down once the frontier shrinks below n / @c Beta nodes.
+ *
+ * The engine keeps a reference to the graph, which must outlive it. An engine is not
+ * safe to share between threads; give each thread its own.
+ */
+
+class BfsEngine {
+public:
+    using NodeId = CompactGraph::NodeId;
+
+    static constexpr std::uint32_t Alpha = 14; ///< Top-down to bottom-up switch factor.
+    static constexpr std::uint32_t Beta = 24;  ///< Bottom-up to top-down switch factor.
+
+    /**
+     * @brief Statistics from the most recent search.
+     */
+    struct Stats {
+        std::size_t expandedNodes = 0;  ///< Nodes that were visited and expanded.
+        std::size_t topDownLevels = 0;  ///< Levels processed top-down.
+        std::size_t bottomUpLevels = 0; ///< Levels processed bottom-up.
+    };
+
+    /**
+     * @brief Creates an engine for the given graph.
+     *
+     * @param graph The graph to search.
+     */
+    explicit BfsEngine(const CompactGraph& graph);
+
+    /**
+     * @brief Finds the shortest path between two nodes.
+     *
+     * @param start ID of the starting node.
+     * @param end ID of the target node.
+     * @return The IDs along the shortest path from start to end.
+     *         Returns an empty vector if no path exists.
+     */
+    std::vector<NodeId> shortestPath(NodeId start, NodeId end);
+
+    /**
+     * @brief Computes the BFS distance from one node to every other node.
+     *
+     * @param source ID of the source node.
+     * @return A vector indexed by node ID holding the number of steps from source,
+     *         or CompactGraph::InvalidId for nodes that cannot be reached.
+     */
+    std::vector<std::uint32_t> distancesFrom(NodeId source);
+
+    /**
+     * @brief Returns statistics about the most recent search.
+     */
+    const Stats& getStats() const { return stats; }
+
+private:
+    /**
+     * @brief Runs the search from start, stopping early once stopAt is reached.
+     *
+     * On return parent[] is valid for every visited node, and depth[] as well when
+     * distances are requested.
+     *
+     * @param start ID of the source node.
+     * @param stopAt ID of a node that ends the search, or InvalidId to explore everything.
+     * @param trackDepth Whether to record the depth of every visited node.
+     * @return True if stopAt was reached.
+     */
+    bool run(NodeId start, NodeId stopAt, bool trackDepth);
+
+    bool isVisited(NodeId id) const { return (visited[id >> 6] >> (id & 63)) & 1u; }
+    void markVisited(NodeId id) { visited[id >> 6] |= std::uint64_t(1) << (id & 63); }
+
+    const CompactGraph& graph;           ///< The graph being searched.
+    std::vector<std::uint64_t> visited;  ///< One bit per node: already discovered.
+    std::vector<std::uint64_t> inFrontier; ///< One bit per node: member of the current frontier.
+    std::vector<NodeId> parent;          ///< BFS tree parent, valid only for visited nodes.
+    std::vector<std::uint32_t> depth;    ///< BFS depth, valid only when tracked.
+    std::vector<NodeId> frontier;        ///< Nodes of the current level.
+    std::vector<NodeId> next;            ///< Nodes of the next level.
+    Stats stats;                         ///< Statistics of the last search.
+};
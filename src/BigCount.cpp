@@ -0,0 +1,93 @@
+#include "BigCount.h"
+#include <algorithm>
+#include <limits>
+
+ BigCount::BigCount(std::uint64_t value) {
+    while (value != 0) {
+        limbs.push_back(static_cast<std::uint32_t>(value));
+        value >>= 32;
+    }
+}
+
+ BigCount& BigCount::operator+=(const BigCount& other) {
+    if (limbs.size() < other.limbs.size()) limbs.resize(other.limbs.size(), 0);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < limbs.size(); ++i) {
+        std::uint64_t sum = carry + limbs[i] + (i < other.limbs.size() ? other.limbs[i] : 0);
+        limbs[i] = static_cast<std::uint32_t>(sum);
+        carry = sum >> 32;
+        if (carry == 0 && i >= other.limbs.size()) break;
+    }
+    if (carry != 0) limbs.push_back(static_cast<std::uint32_t>(carry));
+    return *this;
+}
+
+ BigCount& BigCount::operator-=(const BigCount& other) {
+    std::int64_t borrow = 0;
+    for (std::size_t i = 0; i < limbs.size(); ++i) {
+        std::int64_t difference = std::int64_t(limbs[i]) - borrow - (i < other.limbs.size() ? other.limbs[i] : 0);
+        borrow = difference < 0 ? 1 : 0;
+        limbs[i] = static_cast<std::uint32_t>(difference + (borrow << 32));
+        if (borrow == 0 && i >= other.limbs.size()) break;
+    }
+    trim();
+    return *this;
+}
+
+ bool BigCount::operator<(const BigCount& other) const {
+    if (limbs.size() != other.limbs.size()) return limbs.size() < other.limbs.size();
+    return std::lexicographical_compare(limbs.rbegin(), limbs.rend(), other.limbs.rbegin(), other.limbs.rend());
+}
+
+ std::uint64_t BigCount::toUint64() const {
+    if (!fitsUint64()) return std::numeric_limits<std::uint64_t>::max();
+    std::uint64_t value = 0;
+    for (std::size_t i = limbs.size(); i-- > 0;) value = (value << 32) | limbs[i];
+    return value;
+}
+
+ std::string BigCount::toString() const {
+    if (isZero()) return "0";
+
+    // Peel off nine decimal digits at a time by long division.
+    std::vector<std::uint32_t> rest = limbs;
+    std::vector<std::uint32_t> chunks;
+    while (!rest.empty()) {
+        std::uint64_t remainder = 0;
+        for (std::size_t i = rest.size(); i-- > 0;) {
+            std::uint64_t current = (remainder << 32) | rest[i];
+            rest[i] = static_cast<std::uint32_t>(current / 1000000000u);
+            remainder = current % 1000000000u;
+        }
+        chunks.push_back(static_cast<std::uint32_t>(remainder));
+        while (!rest.empty() && rest.back() == 0) rest.pop_back();
+    }
+
+    std::string text = std::to_string(chunks.back());
+    for (std::size_t i = chunks.size() - 1; i-- > 0;) {
+        std::string chunk = std::to_string(chunks[i]);
+        text += std::string(9 - chunk.size(), '0') + chunk;
+    }
+    return text;
+}
+
+ BigCount BigCount::uniformBelow(const BigCount& bound, std::mt19937& generator) {
+    // Draw random limbs masked to the bound's bit length and reject values that are too
+    // large; at least half of all draws are accepted.
+    const std::uint32_t top = bound.limbs.back();
+    std::uint32_t mask = top;
+    for (unsigned shift = 1; shift < 32; shift <<= 1) mask |= mask >> shift;
+
+    BigCount value;
+    do {
+        value.limbs.resize(bound.limbs.size());
+        for (std::uint32_t& limb : value.limbs) limb = static_cast<std::uint32_t>(generator());
+        value.limbs.back() &= mask;
+        value.trim();
+    } while (!(value < bound));
+    return value;
+}
+
+ void BigCount::trim() {
+    while (!limbs.empty() && limbs.back() == 0) limbs.pop_back();
+}
@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @class BigCount
+ * @brief Unsigned integer of unbounded size for counting ladders.
+ * @ingroup Graph Graph Structures
+ *
+ * The number of optimal ladders grows exponentially with their length on dense graphs and
+ * quickly exceeds 64 bits. BigCount supports only what counting and uniform sampling
+ * need: addition, subtraction of a smaller value, comparison, drawing a uniform value
+ * below a bound, and decimal output.
+ *
+ * The value is stored as 32-bit limbs, least significant first, without leading zero limbs.
+ */
+
+class BigCount {
+public:
+    /**
+     * @brief Constructs a count from a built-in integer.
+     */
+    BigCount(std::uint64_t value = 0);
+
+    BigCount& operator+=(const BigCount& other);
+
+    /**
+     * @brief Subtracts a value that is not larger than this one.
+     */
+    BigCount& operator-=(const BigCount& other);
+
+    bool operator==(const BigCount& other) const { return limbs == other.limbs; }
+    bool operator!=(const BigCount& other) const { return limbs != other.limbs; }
+    bool operator<(const BigCount& other) const;
+
+    bool isZero() const { return limbs.empty(); }
+
+    /**
+     * @brief Returns true if the value fits in 64 bits.
+     */
+    bool fitsUint64() const { return limbs.size() <= 2; }
+
+    /**
+     * @brief Returns the value, saturated at UINT64_MAX.
+     */
+    std::uint64_t toUint64() const;
+
+    /**
+     * @brief Returns the value in decimal.
+     */
+    std::string toString() const;
+
+    /**
+     * @brief Draws a value uniformly from [0, bound).
+     *
+     * @param bound A non-zero upper bound.
+     * @param generator Source of randomness.
+     */
+    static BigCount uniformBelow(const BigCount& bound, std::mt19937& generator);
+
+private:
+    void trim();
+
+    std::vector<std::uint32_t> limbs; ///< Base 2^32 digits, least significant first.
+};
@@ -0,0 +1,22 @@
+#pragma once
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero word.
+ * @ingroup Graph Graph Structures
+ *
+ * @param word A value with at least one bit set.
+ * @return Index of the least significant set bit.
+ */
+inline unsigned lowestBitIndex(std::uint64_t word) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
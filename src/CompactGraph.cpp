@@ -0,0 +1,429 @@
+#include "CompactGraph.h"
+#include <algorithm>
+
+namespace {
+
+/**
+ * @brief Arrays owned by a CompactGraph that was built in memory.
+ */
+struct OwnedArrays {
+    std::vector<std::uint32_t> nodeOffsets;
+    std::vector<CompactGraph::NodeId> neighborIds;
+    std::vector<std::uint32_t> wordOffsets;
+    std::vector<char> wordChars;
+    std::vector<std::uint32_t> componentIds;
+    std::vector<std::uint32_t> componentSizes;
+    std::shared_ptr<const void> borrowedWords; ///< Keeps a borrowed word block alive.
+};
+
+/**
+ * @brief Component labels computed for arrays that are owned elsewhere.
+ */
+struct LabelledArrays {
+    std::shared_ptr<const void> base;
+    std::vector<std::uint32_t> componentIds;
+    std::vector<std::uint32_t> componentSizes;
+};
+
+/**
+ * @brief Search buffers of one thread, reused by every path search it runs.
+ *
+ * A node counts as reached by side s when seen[s] holds the current round, so a new
+ * search increments the round instead of clearing n-sized arrays. The buffers grow to
+ * the largest graph searched on the thread and are cleared only when the round wraps.
+ */
+struct SearchBuffers {
+    std::vector<std::uint32_t> seen[2];             ///< Round in which each node was reached per side.
+    std::vector<CompactGraph::NodeId> parent[2];    ///< BFS parent per side.
+    std::vector<std::uint32_t> dist[2];             ///< BFS depth per side.
+    std::vector<CompactGraph::NodeId> frontier[2];  ///< Current level per side, or the plain BFS queue.
+    std::vector<CompactGraph::NodeId> next;         ///< Level being built.
+    std::uint32_t round = 0;                        ///< Stamp of the current search.
+
+    /**
+     * @brief Starts a new search on a graph of n nodes and returns its round.
+     */
+    std::uint32_t begin(std::size_t n) {
+        if (seen[0].size() < n || ++round == 0) {
+            const std::size_t size = std::max(n, seen[0].size());
+            for (int side = 0; side < 2; ++side) {
+                seen[side].assign(size, 0);
+                parent[side].resize(size);
+                dist[side].resize(size);
+            }
+            round = 1;
+        }
+        return round;
+    }
+};
+
+thread_local SearchBuffers searchBuffers;
+
+/**
+ * @brief Labels connected components with one BFS per component.
+ *
+ * Components are numbered in order of their smallest node ID.
+ */
+void labelComponents(std::size_t n, const std::uint32_t* nodeOffsets, const CompactGraph::NodeId* neighborIds,
+    std::vector<std::uint32_t>& componentIds, std::vector<std::uint32_t>& componentSizes) {
+    componentIds.assign(n, CompactGraph::InvalidId);
+    componentSizes.clear();
+
+    std::vector<CompactGraph::NodeId> queue;
+    queue.reserve(n);
+    for (CompactGraph::NodeId root = 0; root < n; ++root) {
+        if (componentIds[root] != CompactGraph::InvalidId) continue;
+        const std::uint32_t label = static_cast<std::uint32_t>(componentSizes.size());
+
+        queue.clear();
+        queue.push_back(root);
+        componentIds[root] = label;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const CompactGraph::NodeId current = queue[head];
+            for (std::uint32_t i = nodeOffsets[current]; i < nodeOffsets[current + 1]; ++i) {
+                if (componentIds[neighborIds[i]] == CompactGraph::InvalidId) {
+                    componentIds[neighborIds[i]] = label;
+                    queue.push_back(neighborIds[i]);
+                }
+            }
+        }
+        componentSizes.push_back(static_cast<std::uint32_t>(queue.size()));
+    }
+}
+
+/**
+ * @brief Fills the CSR adjacency and component labels of n words from edge lists.
+ */
+void buildAdjacency(std::size_t n, const std::vector<const std::vector<CompactGraph::Edge>*>& edgeLists,
+    OwnedArrays& arrays) {
+    auto& nodeOffsets = arrays.nodeOffsets;
+    auto& neighborIds = arrays.neighborIds;
+
+    // Count degrees, then scatter both directions of every edge into place.
+    nodeOffsets.assign(n + 1, 0);
+    for (const auto* edges : edgeLists) {
+        for (const auto& edge : *edges) {
+            if (edge.first == edge.second) continue;
+            nodeOffsets[edge.first + 1]++;
+            nodeOffsets[edge.second + 1]++;
+        }
+    }
+    for (std::size_t i = 0; i < n; ++i) {
+        nodeOffsets[i + 1] += nodeOffsets[i];
+    }
+
+    neighborIds.resize(nodeOffsets[n]);
+    std::vector<std::uint32_t> cursor(nodeOffsets.begin(), nodeOffsets.end() - 1);
+    for (const auto* edges : edgeLists) {
+        for (const auto& edge : *edges) {
+            if (edge.first == edge.second) continue;
+            neighborIds[cursor[edge.first]++] = edge.second;
+            neighborIds[cursor[edge.second]++] = edge.first;
+        }
+    }
+
+    // Sort each neighbor list and drop duplicate edges, compacting in place.
+    std::uint32_t write = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        auto first = neighborIds.begin() + nodeOffsets[i];
+        auto last = neighborIds.begin() + nodeOffsets[i + 1];
+        std::sort(first, last);
+        last = std::unique(first, last);
+        nodeOffsets[i] = write;
+        for (auto it = first; it != last; ++it) {
+            neighborIds[write++] = *it;
+        }
+    }
+    nodeOffsets[n] = write;
+    neighborIds.resize(write);
+    neighborIds.shrink_to_fit();
+
+    labelComponents(n, nodeOffsets.data(), neighborIds.data(), arrays.componentIds, arrays.componentSizes);
+}
+
+/**
+ * @brief Wraps arrays built in memory in a graph that owns them.
+ */
+CompactGraph adopt(std::shared_ptr<OwnedArrays> arrays, const char* wordChars) {
+    const OwnedArrays& owned = *arrays;
+    return CompactGraph::fromMemory(std::move(arrays), owned.componentIds.size(),
+        owned.nodeOffsets.data(), owned.neighborIds.data(), owned.wordOffsets.data(), wordChars,
+        owned.componentIds.data(), owned.componentSizes.data(), owned.componentSizes.size());
+}
+
+}
+
+ CompactGraph::CompactGraph(const std::vector<std::string_view>& words,
+    const std::vector<Edge>& edges) {
+    assign(words, { &edges });
+}
+
+ CompactGraph::CompactGraph(const std::vector<std::string_view>& words,
+    const std::vector<std::vector<Edge>>& edgeLists) {
+    std::vector<const std::vector<Edge>*> lists;
+    for (const auto& edges : edgeLists) lists.push_back(&edges);
+    assign(words, lists);
+}
+
+ void CompactGraph::assign(const std::vector<std::string_view>& words,
+    const std::vector<const std::vector<Edge>*>& edgeLists) {
+    auto arrays = std::make_shared<OwnedArrays>();
+    arrays->wordOffsets.reserve(words.size() + 1);
+    arrays->wordOffsets.push_back(0);
+    for (std::string_view word : words) {
+        arrays->wordChars.insert(arrays->wordChars.end(), word.begin(), word.end());
+        arrays->wordOffsets.push_back(static_cast<std::uint32_t>(arrays->wordChars.size()));
+    }
+    buildAdjacency(words.size(), edgeLists, *arrays);
+    const char* wordChars = arrays->wordChars.data();
+    *this = adopt(std::move(arrays), wordChars);
+}
+
+ CompactGraph CompactGraph::fromWordBlock(std::shared_ptr<const void> wordStorage, const char* wordChars,
+    std::size_t wordLength, std::size_t count, const std::vector<const std::vector<Edge>*>& edgeLists) {
+    auto arrays = std::make_shared<OwnedArrays>();
+    arrays->wordOffsets.resize(count + 1);
+    for (std::size_t i = 0; i <= count; ++i) {
+        arrays->wordOffsets[i] = static_cast<std::uint32_t>(i * wordLength);
+    }
+    arrays->borrowedWords = std::move(wordStorage);
+    buildAdjacency(count, edgeLists, *arrays);
+    return adopt(std::move(arrays), wordChars);
+}
+
+ CompactGraph CompactGraph::fromGraph(const Graph<std::string>& graph) {
+    const auto& adjacency = graph.getAdjacencyList();
+
+    std::vector<std::string_view> words;
+    words.reserve(adjacency.size());
+    for (const auto& entry : adjacency) {
+        words.push_back(entry.first);
+    }
+
+    // std::map iterates in sorted order, so the position of a word is its ID.
+    std::vector<Edge> edges;
+    NodeId id = 0;
+    for (const auto& entry : adjacency) {
+        for (const auto& neighbor : entry.second) {
+            NodeId neighborId = static_cast<NodeId>(
+                std::lower_bound(words.begin(), words.end(), neighbor) - words.begin());
+            if (id < neighborId) {
+                edges.emplace_back(id, neighborId);
+            }
+        }
+        ++id;
+    }
+
+    return CompactGraph(words, edges);
+}
+
+ CompactGraph CompactGraph::fromMemory(std::shared_ptr<const void> storage, std::size_t nodeCount,
+    const std::uint32_t* nodeOffsets, const NodeId* neighborIds,
+    const std::uint32_t* wordOffsets, const char* wordChars,
+    const std::uint32_t* componentIds, const std::uint32_t* componentSizes, std::size_t componentCount) {
+    CompactGraph graph;
+    graph.nodes = nodeCount;
+    graph.nodeOffsets = nodeOffsets;
+    graph.neighborIds = neighborIds;
+    graph.wordOffsets = wordOffsets;
+    graph.wordChars = wordChars;
+
+    if (componentIds) {
+        graph.storage = std::move(storage);
+        graph.componentIds = componentIds;
+        graph.componentSizes = componentSizes;
+        graph.components = componentCount;
+    }
+    else {
+        auto labelled = std::make_shared<LabelledArrays>();
+        labelComponents(nodeCount, nodeOffsets, neighborIds, labelled->componentIds, labelled->componentSizes);
+        labelled->base = std::move(storage);
+        graph.componentIds = labelled->componentIds.data();
+        graph.componentSizes = labelled->componentSizes.data();
+        graph.components = labelled->componentSizes.size();
+        graph.storage = std::move(labelled);
+    }
+    return graph;
+}
+
+ CompactGraph::NodeId CompactGraph::idOf(const std::string& word) const {
+    std::size_t lo = 0;
+    std::size_t hi = nodeCount();
+    while (lo < hi) {
+        std::size_t mid = lo + (hi - lo) / 2;
+        int cmp = word.compare(0, std::string::npos,
+            wordChars + wordOffsets[mid], wordOffsets[mid + 1] - wordOffsets[mid]);
+        if (cmp == 0) return static_cast<NodeId>(mid);
+        if (cmp > 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return InvalidId;
+}
+
+ std::string CompactGraph::wordOf(NodeId id) const {
+    return std::string(wordChars + wordOffsets[id], wordOffsets[id + 1] - wordOffsets[id]);
+}
+
+ std::vector<CompactGraph::NodeId> CompactGraph::shortestPath(NodeId start, NodeId end,
+    std::size_t* expandedNodes) const {
+    const std::size_t n = nodeCount();
+    if (expandedNodes) *expandedNodes = 0;
+    if (start >= n || end >= n || !connected(start, end)) return {};
+
+    SearchBuffers& buffers = searchBuffers;
+    const std::uint32_t round = buffers.begin(n);
+    std::vector<std::uint32_t>& seen = buffers.seen[0];
+    std::vector<NodeId>& parent = buffers.parent[0];
+    std::vector<NodeId>& queue = buffers.frontier[0];
+
+    queue.assign(1, start);
+    seen[start] = round;
+    parent[start] = start;
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        NodeId current = queue[head];
+        if (expandedNodes) *expandedNodes = head + 1;
+
+        if (current == end) {
+            std::vector<NodeId> path;
+            for (NodeId node = end; node != start; node = parent[node]) {
+                path.push_back(node);
+            }
+            path.push_back(start);
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        for (const NodeId* it = neighborsBegin(current); it != neighborsEnd(current); ++it) {
+            if (seen[*it] != round) {
+                seen[*it] = round;
+                parent[*it] = current;
+                queue.push_back(*it);
+            }
+        }
+    }
+
+    return {}; ///< No path found
+}
+
+ std::vector<CompactGraph::NodeId> CompactGraph::bidirectionalShortestPath(NodeId start, NodeId end,
+    std::size_t* expandedNodes) const {
+    const std::size_t n = nodeCount();
+    if (expandedNodes) *expandedNodes = 0;
+    if (start >= n || end >= n || !connected(start, end)) return {};
+    if (start == end) return { start };
+
+    // Index 0 holds the search from start, index 1 the search from end.
+    SearchBuffers& buffers = searchBuffers;
+    const std::uint32_t round = buffers.begin(n);
+    std::vector<std::uint32_t>* seen = buffers.seen;
+    std::vector<NodeId>* parent = buffers.parent;
+    std::vector<std::uint32_t>* dist = buffers.dist;
+    std::vector<NodeId>* frontier = buffers.frontier;
+    const NodeId roots[2] = { start, end };
+    for (int side = 0; side < 2; ++side) {
+        frontier[side].assign(1, roots[side]);
+        seen[side][roots[side]] = round;
+        parent[side][roots[side]] = roots[side];
+        dist[side][roots[side]] = 0;
+    }
+
+    std::vector<NodeId>& next = buffers.next;
+    while (!frontier[0].empty() && !frontier[1].empty()) {
+        const int side = frontier[0].size() <= frontier[1].size() ? 0 : 1;
+        const int other = 1 - side;
+
+        next.clear();
+        std::uint32_t bestLength = 0;
+        NodeId meetOwn = InvalidId;
+        NodeId meetOther = InvalidId;
+
+        if (expandedNodes) *expandedNodes += frontier[side].size();
+        for (NodeId current : frontier[side]) {
+            const std::uint32_t depth = dist[side][current];
+            for (const NodeId* it = neighborsBegin(current); it != neighborsEnd(current); ++it) {
+                const NodeId neighbor = *it;
+                if (seen[other][neighbor] == round) {
+                    std::uint32_t length = depth + 1 + dist[other][neighbor];
+                    if (meetOwn == InvalidId || length < bestLength) {
+                        bestLength = length;
+                        meetOwn = current;
+                        meetOther = neighbor;
+                    }
+                }
+                if (seen[side][neighbor] != round) {
+                    seen[side][neighbor] = round;
+                    parent[side][neighbor] = current;
+                    dist[side][neighbor] = depth + 1;
+                    next.push_back(neighbor);
+                }
+            }
+        }
+
+        if (meetOwn != InvalidId) {
+            const NodeId meetForward = side == 0 ? meetOwn : meetOther;
+            const NodeId meetBackward = side == 0 ? meetOther : meetOwn;
+
+            std::vector<NodeId> path;
+            for (NodeId node = meetForward; node != start; node = parent[0][node]) {
+                path.push_back(node);
+            }
+            path.push_back(start);
+            std::reverse(path.begin(), path.end());
+            for (NodeId node = meetBackward; node != end; node = parent[1][node]) {
+                path.push_back(node);
+            }
+            path.push_back(end);
+            return path;
+        }
+
+        frontier[side].swap(next);
+    }
+
+    return {}; ///< No path found
+}
+
+ std::vector<std::uint32_t> CompactGraph::distancesFrom(NodeId source) const {
+    const std::size_t n = nodeCount();
+    std::vector<std::uint32_t> dist(n, InvalidId);
+    if (source >= n) return dist;
+
+    std::vector<NodeId> queue;
+    queue.reserve(n);
+    queue.push_back(source);
+    dist[source] = 0;
+
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        NodeId current = queue[head];
+        for (const NodeId* it = neighborsBegin(current); it != neighborsEnd(current); ++it) {
+            if (dist[*it] == InvalidId) {
+                dist[*it] = dist[current] + 1;
+                queue.push_back(*it);
+            }
+        }
+    }
+    return dist;
+}
+
+ std::uint64_t CompactGraph::fingerprint() const {
+    std::uint64_t hash = 0xcbf29ce484222325ull ^ nodes;
+    auto mix = [&hash](std::uint64_t value) {
+        hash = (hash ^ value) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    };
+    if (nodes == 0) return hash;
+    for (std::size_t i = 0; i <= nodes; ++i) mix(nodeOffsets[i]);
+    for (std::uint32_t i = 0; i < nodeOffsets[nodes]; ++i) mix(neighborIds[i]);
+    for (std::size_t i = 0; i <= nodes; ++i) mix(wordOffsets[i]);
+    for (std::uint32_t i = 0; i < wordOffsets[nodes]; ++i) mix(static_cast<unsigned char>(wordChars[i]));
+    return hash;
+}
+
+ std::size_t CompactGraph::memoryUsage() const {
+    if (nodes == 0) return 0;
+    return (nodes + 1) * sizeof(std::uint32_t) * 2
+        + nodeOffsets[nodes] * sizeof(NodeId)
+        + wordOffsets[nodes]
+        + nodes * sizeof(std::uint32_t)
+        + components * sizeof(std::uint32_t);
+}
@@ -0,0 +1,263 @@
+#pragma once
+#include "Graph.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/**
+ * @class CompactGraph
+ * @brief A frozen word graph stored in compressed sparse row (CSR) form.
+ * @ingroup Graph Graph Structures
+ *
+ * Every word is identified by a 32-bit ID. IDs are assigned in lexicographic order,
+ * so neighbor lists sorted by ID visit words in the same order as Graph<std::string>.
+ * The neighbors of word @c i are stored contiguously in
+ * @c neighborIds[nodeOffsets[i] .. nodeOffsets[i + 1]), and the characters of all words
+ * live in a single character block indexed by @c wordOffsets. That block may belong to
+ * the graph or be borrowed from a word arena such as a DictionaryIndex bucket, so a
+ * word's text is not copied into every graph built over it.
+ *
+ * Connected components are labelled once when the graph is built. Components are
+ * numbered in order of their smallest word ID, so two words are connected exactly when
+ * their labels are equal, which makes reachability a constant-time check.
+ *
+ * The arrays are immutable once built and are reached through a shared storage handle,
+ * which is either memory owned by the graph or a read-only mapping of a GraphImage file.
+ * Copying a CompactGraph therefore shares the arrays instead of duplicating them.
+ */
+
+class CompactGraph {
+public:
+    using NodeId = std::uint32_t;
+    using Edge = std::pair<NodeId, NodeId>;
+
+    /**
+     * @brief Sentinel ID returned when a word is not part of the graph.
+     */
+    static constexpr NodeId InvalidId = static_cast<NodeId>(-1);
+
+    /**
+     * @brief Constructs an empty graph.
+     */
+    CompactGraph() = default;
+
+    /**
+     * @brief Builds a compact graph from a list of words and an edge list.
+     *
+     * @param words Sorted list of unique words. The index of a word becomes its ID.
+     * @param edges Undirected edges given as pairs of word IDs. Duplicates are ignored.
+     */
+    CompactGraph(const std::vector<std::string_view>& words,
+        const std::vector<Edge>& edges);
+
+    /**
+     * @brief Builds a compact graph from a list of words and several edge lists.
+     *
+     * Equivalent to concatenating the lists, without materializing the concatenation.
+     *
+     * @param words Sorted list of unique words. The index of a word becomes its ID.
+     * @param edgeLists Lists of undirected edges given as pairs of word IDs.
+     */
+    CompactGraph(const std::vector<std::string_view>& words,
+        const std::vector<std::vector<Edge>>& edgeLists);
+
+    /**
+     * @brief Builds a compact graph over words stored back to back in an existing block.
+     *
+     * The characters are not copied; the graph keeps wordStorage alive instead.
+     *
+     * @param wordStorage Handle that keeps the characters alive for as long as the graph exists.
+     * @param wordChars Sorted, unique words of wordLength characters each, without separators.
+     * @param wordLength Number of characters per word.
+     * @param count Number of words. The index of a word becomes its ID.
+     * @param edgeLists Lists of undirected edges given as pairs of word IDs.
+     * @return A CompactGraph borrowing the word block.
+     */
+    static CompactGraph fromWordBlock(std::shared_ptr<const void> wordStorage, const char* wordChars,
+        std::size_t wordLength, std::size_t count, const std::vector<const std::vector<Edge>*>& edgeLists);
+
+    /**
+     * @brief Freezes an adjacency-list graph into compact form.
+     *
+     * @param graph The graph to convert.
+     * @return A CompactGraph with the same nodes and edges.
+     */
+    static CompactGraph fromGraph(const Graph<std::string>& graph);
+
+    /**
+     * @brief Wraps existing CSR arrays, such as a mapped GraphImage, without copying them.
+     *
+     * @param storage Handle that keeps the arrays alive for as long as the graph exists.
+     * @param nodeCount Number of words.
+     * @param nodeOffsets Neighbor range offsets (nodeCount + 1 entries).
+     * @param neighborIds Concatenated, sorted neighbor lists.
+     * @param wordOffsets Word offsets into wordChars (nodeCount + 1 entries).
+     * @param wordChars Characters of all words, sorted lexicographically.
+     * @param componentIds Component label of every word (nodeCount entries), or nullptr to
+     *        label the components now.
+     * @param componentSizes Number of words in each component.
+     * @param componentCount Number of components.
+     * @return A CompactGraph viewing the given arrays.
+     */
+    static CompactGraph fromMemory(std::shared_ptr<const void> storage, std::size_t nodeCount,
+        const std::uint32_t* nodeOffsets, const NodeId* neighborIds,
+        const std::uint32_t* wordOffsets, const char* wordChars,
+        const std::uint32_t* componentIds = nullptr, const std::uint32_t* componentSizes = nullptr,
+        std::size_t componentCount = 0);
+
+    /**
+     * @brief Returns the number of words in the graph.
+     */
+    std::size_t nodeCount() const { return nodes; }
+
+    /**
+     * @brief Returns the number of undirected edges in the graph.
+     */
+    std::size_t edgeCount() const { return nodes == 0 ? 0 : nodeOffsets[nodes] / 2; }
+
+    /**
+     * @brief Looks up the ID of a word.
+     *
+     * @param word The word to look up.
+     * @return The word's ID, or InvalidId if it is not in the graph.
+     */
+    NodeId idOf(const std::string& word) const;
+
+    /**
+     * @brief Returns the word with the given ID.
+     *
+     * @param id A valid word ID.
+     * @return The word as a string.
+     */
+    std::string wordOf(NodeId id) const;
+
+    /**
+     * @brief Returns a pointer to the characters of a word (not null-terminated).
+     */
+    const char* wordData(NodeId id) const { return wordChars + wordOffsets[id]; }
+
+    /**
+     * @brief Returns the number of characters in a word.
+     */
+    std::size_t wordLength(NodeId id) const { return wordOffsets[id + 1] - wordOffsets[id]; }
+
+    /**
+     * @brief Checks if the graph contains a specific word.
+     */
+    bool contains(const std::string& word) const { return idOf(word) != InvalidId; }
+
+    /**
+     * @brief Returns a pointer to the first neighbor ID of a node.
+     */
+    const NodeId* neighborsBegin(NodeId id) const { return neighborIds + nodeOffsets[id]; }
+
+    /**
+     * @brief Returns a pointer one past the last neighbor ID of a node.
+     */
+    const NodeId* neighborsEnd(NodeId id) const { return neighborIds + nodeOffsets[id + 1]; }
+
+    /**
+     * @brief Returns the number of neighbors of a node.
+     */
+    std::size_t degree(NodeId id) const { return nodeOffsets[id + 1] - nodeOffsets[id]; }
+
+    /**
+     * @brief Returns the number of connected components, counting isolated words.
+     */
+    std::size_t componentCount() const { return components; }
+
+    /**
+     * @brief Returns the component label of a word, in [0, componentCount()).
+     */
+    std::uint32_t componentOf(NodeId id) const { return componentIds[id]; }
+
+    /**
+     * @brief Returns the number of words in a component.
+     */
+    std::size_t componentSize(std::uint32_t component) const { return componentSizes[component]; }
+
+    /**
+     * @brief Checks whether a path exists between two words, in constant time.
+     */
+    bool connected(NodeId a, NodeId b) const { return componentIds[a] == componentIds[b]; }
+
+    /**
+     * @brief Finds the shortest path between two nodes using BFS over the flat arrays.
+     *
+     * Searches run on buffers kept per thread, so a query allocates only its result.
+     *
+     * @param start ID of the starting node.
+     * @param end ID of the target node.
+     * @param expandedNodes Optional output receiving the number of nodes dequeued.
+     * @return The IDs along the shortest path from start to end.
+     *         Returns an empty vector, without searching, if the nodes are not connected.
+     */
+    std::vector<NodeId> shortestPath(NodeId start, NodeId end, std::size_t* expandedNodes = nullptr) const;
+
+    /**
+     * @brief Finds the shortest path between two nodes using bidirectional BFS.
+     *
+     * Grows the smaller of the two frontiers one level at a time and joins the two
+     * halves at the cheapest meeting edge of the first level where they touch. Like
+     * shortestPath(), it reuses the calling thread's search buffers.
+     *
+     * @param start ID of the starting node.
+     * @param end ID of the target node.
+     * @param expandedNodes Optional output receiving the number of nodes expanded.
+     * @return The IDs along the shortest path from start to end.
+     *         Returns an empty vector, without searching, if the nodes are not connected.
+     */
+    std::vector<NodeId> bidirectionalShortestPath(NodeId start, NodeId end,
+        std::size_t* expandedNodes = nullptr) const;
+
+    /**
+     * @brief Computes the BFS distance from one node to every other node.
+     *
+     * @param source ID of the source node.
+     * @return A vector indexed by node ID holding the number of steps from source,
+     *         or InvalidId for nodes that cannot be reached.
+     */
+    std::vector<std::uint32_t> distancesFrom(NodeId source) const;
+
+    /**
+     * @brief Returns the approximate number of bytes used by the graph arrays.
+     */
+    std::size_t memoryUsage() const;
+
+    /**
+     * @brief Returns a 64-bit hash of the word table and adjacency.
+     *
+     * Used to check that data derived from a graph, such as a saved index, still matches it.
+     */
+    std::uint64_t fingerprint() const;
+
+    /**
+     * @brief Raw access to the CSR arrays, for serialization.
+     */
+    const std::uint32_t* getNodeOffsets() const { return nodeOffsets; }
+    const NodeId* getNeighborIds() const { return neighborIds; }
+    const std::uint32_t* getWordOffsets() const { return wordOffsets; }
+    const char* getWordChars() const { return wordChars; }
+    const std::uint32_t* getComponentIds() const { return componentIds; }
+    const std::uint32_t* getComponentSizes() const { return componentSizes; }
+
+private:
+    /**
+     * @brief Fills the word table and CSR arrays from words and edge lists.
+     */
+    void assign(const std::vector<std::string_view>& words,
+        const std::vector<const std::vector<Edge>*>& edgeLists);
+
+    std::shared_ptr<const void> storage;          ///< Keeps the arrays below alive.
+    std::size_t nodes = 0;                        ///< Number of words.
+    const std::uint32_t* nodeOffsets = nullptr;   ///< Start of each node's neighbor range (size n + 1).
+    const NodeId* neighborIds = nullptr;          ///< Concatenated, sorted neighbor lists.
+    const std::uint32_t* wordOffsets = nullptr;   ///< Start of each word in wordChars (size n + 1).
+    const char* wordChars = nullptr;              ///< Characters of all words, back to back.
+    const std::uint32_t* componentIds = nullptr;  ///< Component label of each word (size n).
+    const std::uint32_t* componentSizes = nullptr; ///< Number of words per component.
+    std::size_t components = 0;                   ///< Number of components.
+};
@@ -0,0 +1,113 @@
+#include "DictionaryIndex.h"
+#include "CompactGraph.h"
+#include "GraphImage.h"
+#include "MappedDictionary.h"
+#include "PackedWord.h"
+#include <algorithm>
+
+namespace {
+
+inline std::size_t slotOf(std::uint64_t key, std::size_t mask) {
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+}
+
+ DictionaryIndex::DictionaryIndex(const std::vector<std::string_view>& words) {
+    std::vector<std::vector<std::string_view>> byLength;
+    for (std::string_view word : words) {
+        if (word.empty()) continue;
+        if (word.size() >= byLength.size()) byLength.resize(word.size() + 1);
+        byLength[word.size()].push_back(word);
+    }
+
+    buckets.resize(byLength.size());
+    for (std::size_t length = 1; length < byLength.size(); ++length) {
+        std::vector<std::string_view>& sorted = byLength[length];
+        std::sort(sorted.begin(), sorted.end());
+        sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+        Bucket& bucket = buckets[length];
+        bucket.count = sorted.size();
+        totalWords += sorted.size();
+        bucket.chars.reserve(sorted.size() * length);
+        for (std::string_view word : sorted) bucket.chars.append(word.data(), word.size());
+
+        if (sorted.empty()) continue;
+        std::size_t capacity = 16;
+        while (capacity < sorted.size() * 2) capacity <<= 1;
+        bucket.slots.resize(capacity);
+        const std::size_t mask = capacity - 1;
+        for (std::size_t i = 0; i < sorted.size(); ++i) {
+            bool exact;
+            const std::uint64_t key = keyOf(sorted[i], exact);
+            std::size_t slot = slotOf(key, mask);
+            while (bucket.slots[slot].index != 0) slot = (slot + 1) & mask;
+            bucket.slots[slot] = { key, static_cast<std::uint32_t>(i + 1) };
+        }
+    }
+}
+
+ std::shared_ptr<const DictionaryIndex> DictionaryIndex::load(const std::string& filename) {
+    MappedDictionary dictionary(filename);
+    return std::make_shared<const DictionaryIndex>(dictionary.getWords());
+}
+
+ std::shared_ptr<const DictionaryIndex> DictionaryIndex::fromImage(const GraphImage& image) {
+    // The views point into the mapped graphs, which the image keeps alive.
+    std::vector<std::string_view> words;
+    for (std::size_t length : image.getWordLengths()) {
+        CompactGraph graph = image.getGraph(length);
+        for (CompactGraph::NodeId id = 0; id < graph.nodeCount(); ++id) {
+            words.emplace_back(graph.wordData(id), graph.wordLength(id));
+        }
+    }
+    return std::make_shared<const DictionaryIndex>(words);
+}
+
+ std::vector<std::size_t> DictionaryIndex::getWordLengths() const {
+    std::vector<std::size_t> lengths;
+    for (std::size_t length = 1; length < buckets.size(); ++length) {
+        if (buckets[length].count != 0) lengths.push_back(length);
+    }
+    return lengths;
+}
+
+ std::vector<std::string> DictionaryIndex::getWords(std::size_t length) const {
+    std::vector<std::string> words;
+    words.reserve(wordCount(length));
+    for (std::size_t i = 0; i < wordCount(length); ++i) words.emplace_back(word(length, i));
+    return words;
+}
+
+ std::size_t DictionaryIndex::indexOf(std::string_view word) const {
+    if (word.size() >= buckets.size() || buckets[word.size()].count == 0) return NotFound;
+    const Bucket& bucket = buckets[word.size()];
+
+    bool exact;
+    const std::uint64_t key = keyOf(word, exact);
+    const std::size_t mask = bucket.slots.size() - 1;
+    for (std::size_t slot = slotOf(key, mask); bucket.slots[slot].index != 0; slot = (slot + 1) & mask) {
+        const Slot& entry = bucket.slots[slot];
+        if (entry.key == key && (exact || this->word(word.size(), entry.index - 1) == word)) return entry.index - 1;
+    }
+    return NotFound;
+}
+
+ std::size_t DictionaryIndex::memoryUsage() const {
+    std::size_t bytes = sizeof(*this) + buckets.capacity() * sizeof(Bucket);
+    for (const Bucket& bucket : buckets) {
+        bytes += bucket.chars.capacity() + bucket.slots.capacity() * sizeof(Slot);
+    }
+    return bytes;
+}
+
+ std::uint64_t DictionaryIndex::keyOf(std::string_view word, bool& exact) {
+    std::uint64_t key;
+    exact = PackedWord::pack(word.data(), word.size(), key);
+    if (exact) return key;
+
+    std::uint64_t h = 0xcbf29ce484222325ull;
+    for (char c : word) h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    return (h >> 1) | (std::uint64_t(1) << 63);
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class GraphImage;
+
+/**
+ * @class DictionaryIndex
+ * @brief An immutable index of the dictionary's words, bucketed by length.
+ * @ingroup Graph Graph Structures
+ *
+ * The dictionary is read once and every word of a given length is stored in one
+ * contiguous, sorted block of fixed-width entries. A word's index within its bucket
+ * therefore equals its node ID in the CompactGraph of that length. Each bucket also keeps
+ * an open-addressing hash table for membership: words of up to 12 letters are keyed by
+ * their exact PackedWord code, longer ones by an FNV-1a hash confirmed against the text.
+ *
+ * The index is the one place where word text is stored: graphs built from it borrow a
+ * bucket's characters, solvers use it to turn words into IDs, and the word lists of the
+ * GUI read from it directly. It is created once and shared as a pointer to const, so any
+ * number of threads may read it without locking.
+ */
+
+class DictionaryIndex {
+public:
+    static constexpr std::size_t NotFound = static_cast<std::size_t>(-1); ///< Returned by indexOf() for unknown words.
+
+    /**
+     * @brief Builds the index from a list of upper-case words.
+     *
+     * @param words Words in any order; repeated words are stored once.
+     */
+    explicit DictionaryIndex(const std::vector<std::string_view>& words);
+
+    /**
+     * @brief Reads a dictionary file through MappedDictionary and indexes it.
+     *
+     * @param filename Path to the dictionary file.
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    static std::shared_ptr<const DictionaryIndex> load(const std::string& filename);
+
+    /**
+     * @brief Indexes the words of every graph in a precompiled graph image.
+     *
+     * @param image The opened image.
+     */
+    static std::shared_ptr<const DictionaryIndex> fromImage(const GraphImage& image);
+
+    /**
+     * @brief Returns the word lengths that have at least one word, in ascending order.
+     */
+    std::vector<std::size_t> getWordLengths() const;
+
+    /**
+     * @brief Returns the number of words of one length.
+     */
+    std::size_t wordCount(std::size_t length) const {
+        return length < buckets.size() ? buckets[length].count : 0;
+    }
+
+    /**
+     * @brief Returns the total number of words.
+     */
+    std::size_t size() const { return totalWords; }
+
+    /**
+     * @brief Returns a word by its index within its length's bucket.
+     *
+     * @param length Word length.
+     * @param index Index below wordCount(length), in lexicographic order.
+     */
+    std::string_view word(std::size_t length, std::size_t index) const {
+        return std::string_view(buckets[length].chars.data() + index * length, length);
+    }
+
+    /**
+     * @brief Returns a copy of all words of one length, in lexicographic order.
+     */
+    std::vector<std::string> getWords(std::size_t length) const;
+
+    /**
+     * @brief Returns the index of a word within its length's bucket.
+     *
+     * @param word Upper-case word.
+     * @return The index, or NotFound if the word is not in the dictionary.
+     */
+    std::size_t indexOf(std::string_view word) const;
+
+    /**
+     * @brief Checks whether a word is in the dictionary.
+     */
+    bool contains(std::string_view word) const { return indexOf(word) != NotFound; }
+
+    /**
+     * @brief Returns the number of bytes held by the word blocks and hash tables.
+     */
+    std::size_t memoryUsage() const;
+
+private:
+    /**
+     * @brief Hash table slot of one word.
+     */
+    struct Slot {
+        std::uint64_t key = 0;     ///< Packed code or tagged hash of the word.
+        std::uint32_t index = 0;   ///< One plus the word's index, or 0 if empty.
+    };
+
+    /**
+     * @brief The words of one length.
+     */
+    struct Bucket {
+        std::string chars;         ///< Sorted words, each exactly length characters.
+        std::size_t count = 0;     ///< Number of words.
+        std::vector<Slot> slots;   ///< Membership table, a power of two in size.
+    };
+
+    /**
+     * @brief Returns the hash table key of a word and whether it identifies the word exactly.
+     */
+    static std::uint64_t keyOf(std::string_view word, bool& exact);
+
+    std::vector<Bucket> buckets;   ///< Buckets indexed by word length.
+    std::size_t totalWords = 0;    ///< Words over all buckets.
+};
@@ -79,18 +79,29 @@ public:
         return emptySet;
     }
 
+    /**
+     * @brief Provides read-only access to the whole adjacency list.
+     *
+     * @return A const reference to the map from each node to its neighbors.
+     */
+    const std::map<T, std::set<T>>& getAdjacencyList() const {
+        return adjacencyList;
+    }
+
     /**
      * @brief Finds the shortest path between two nodes using BFS.
      *
      * @param start The starting node.
      * @param end The target node.
+     * @param expandedNodes Optional output receiving the number of nodes dequeued.
      * @return A vector representing the shortest path from start to end.
      *         Returns an empty vector if no path exists.
      */
-    std::vector<T> shortestPath(const T& start, const T& end) const {
+    std::vector<T> shortestPath(const T& start, const T& end, size_t* expandedNodes = nullptr) const {
         std::map<T, T> parent;
         std::queue<T> q;
         std::set<T> visited;
+        if (expandedNodes) *expandedNodes = 0;
 
         q.push(start);
         visited.insert(start);
@@ -99,6 +110,7 @@ public:
         while (!q.empty()) {
             T current = q.front();
             q.pop();
+            if (expandedNodes) ++*expandedNodes;
 
             if (current == end) {
                 std::vector<T> path;
@@ -121,4 +133,89 @@ public:
 
         return {}; ///< No path found
     }
+
+    /**
+     * @brief Finds the shortest path between two nodes using bidirectional BFS.
+     *
+     * Two searches are grown level by level, one from each end, always expanding the
+     * smaller frontier. When a level touches the other search, the whole level is still
+     * scanned and the meeting edge with the smallest total length is used, so the
+     * returned path is optimal.
+     *
+     * @param start The starting node.
+     * @param end The target node.
+     * @param expandedNodes Optional output receiving the number of nodes expanded.
+     * @return A vector representing the shortest path from start to end.
+     *         Returns an empty vector if no path exists.
+     */
+    std::vector<T> bidirectionalShortestPath(const T& start, const T& end, size_t* expandedNodes = nullptr) const {
+        if (expandedNodes) *expandedNodes = 0;
+        if (start == end) {
+            return { start };
+        }
+
+        std::map<T, T> parentForward, parentBackward;
+        std::map<T, size_t> distForward, distBackward;
+        std::vector<T> frontierForward{ start }, frontierBackward{ end };
+
+        parentForward[start] = start;
+        distForward[start] = 0;
+        parentBackward[end] = end;
+        distBackward[end] = 0;
+
+        while (!frontierForward.empty() && !frontierBackward.empty()) {
+            bool forward = frontierForward.size() <= frontierBackward.size();
+            std::vector<T>& frontier = forward ? frontierForward : frontierBackward;
+            std::map<T, T>& parent = forward ? parentForward : parentBackward;
+            std::map<T, size_t>& dist = forward ? distForward : distBackward;
+            const std::map<T, size_t>& otherDist = forward ? distBackward : distForward;
+
+            std::vector<T> next;
+            size_t bestLength = 0;
+            const T* meetOwn = nullptr;
+            const T* meetOther = nullptr;
+
+            for (const T& current : frontier) {
+                if (expandedNodes) ++*expandedNodes;
+                size_t depth = dist[current];
+                for (const T& neighbor : getNeighbors(current)) {
+                    auto other = otherDist.find(neighbor);
+                    if (other != otherDist.end()) {
+                        size_t length = depth + 1 + other->second;
+                        if (!meetOwn || length < bestLength) {
+                            bestLength = length;
+                            meetOwn = &current;
+                            meetOther = &other->first;
+                        }
+                    }
+                    if (dist.find(neighbor) == dist.end()) {
+                        dist[neighbor] = depth + 1;
+                        parent[neighbor] = current;
+                        next.push_back(neighbor);
+                    }
+                }
+            }
+
+            if (meetOwn) {
+                const T& meetForward = forward ? *meetOwn : *meetOther;
+                const T& meetBackward = forward ? *meetOther : *meetOwn;
+
+                std::vector<T> path;
+                for (T node = meetForward; node != start; node = parentForward[node]) {
+                    path.push_back(node);
+                }
+                path.push_back(start);
+                std::reverse(path.begin(), path.end());
+                for (T node = meetBackward; node != end; node = parentBackward[node]) {
+                    path.push_back(node);
+                }
+                path.push_back(end);
+                return path;
+            }
+
+            frontier.swap(next);
+        }
+
+        return {}; ///< No path found
+    }
 };
@@ -1,32 +1,153 @@
 #include "GraphBuilder.h"
-#include <fstream>
+#include "DictionaryIndex.h"
+#include "PackedWord.h"
+#include "MappedDictionary.h"
 #include <algorithm>
 #include <stdexcept>
+#include <thread>
+#include <unordered_map>
 
+namespace {
 
- void GraphBuilder::buildPatternMap(const std::vector<std::string>& words) {
-    for (const auto& word : words) {
-        for (size_t i = 0; i < word.length(); ++i) {
-            std::string pattern = word;
+/**
+ * @brief A pattern key paired with the ID of a word that produces it.
+ */
+struct PatternEntry {
+    std::uint64_t key;
+    CompactGraph::NodeId id;
+
+    bool operator<(const PatternEntry& other) const {
+        return key != other.key ? key < other.key : id < other.id;
+    }
+};
+
+/**
+ * @brief Connects the flagged words by string pattern.
+ *
+ * The flags come from PatternIndex::stringKeyedWords(). Words that do not fit a packed
+ * code are rare, so a plain hash map is good enough.
+ */
+void appendStringPatternEdges(const std::vector<std::string_view>& words,
+    const std::vector<unsigned char>& stringKeyed, std::vector<CompactGraph::Edge>& edges) {
+    std::unordered_map<std::string, std::vector<CompactGraph::NodeId>> buckets;
+    for (size_t id = 0; id < words.size(); ++id) {
+        if (!stringKeyed[id]) continue;
+        std::string pattern(words[id]);
+        for (size_t i = 0; i < pattern.length(); ++i) {
+            char letter = pattern[i];
             pattern[i] = '*';
-            patternMap[pattern].insert(word);
+            buckets[pattern].push_back(static_cast<CompactGraph::NodeId>(id));
+            pattern[i] = letter;
+        }
+    }
+    for (const auto& entry : buckets) {
+        const auto& ids = entry.second;
+        for (size_t a = 0; a < ids.size(); ++a) {
+            for (size_t b = a + 1; b < ids.size(); ++b) {
+                edges.emplace_back(ids[a], ids[b]);
+            }
         }
     }
 }
 
- std::vector<std::string> GraphBuilder::loadDictionary(const std::string& filename, size_t wordLength) {
-    std::vector<std::string> words;
-    std::ifstream file(filename);
-    if (!file.is_open()) {
-        throw std::runtime_error("Could not open dictionary file");
+/**
+ * @brief Runs fn(0) .. fn(threadCount - 1) on separate threads and waits for all of them.
+ */
+template <typename Fn>
+void runOnThreads(unsigned threadCount, Fn fn) {
+    std::vector<std::thread> threads;
+    threads.reserve(threadCount);
+    for (unsigned t = 0; t < threadCount; ++t) {
+        threads.emplace_back(fn, t);
+    }
+    for (auto& thread : threads) {
+        thread.join();
     }
+}
+
+}
+
+
+ void GraphBuilder::prepareWords(const std::vector<std::string>& words) {
+    indexedWords.assign(words.begin(), words.end());
+    std::sort(indexedWords.begin(), indexedWords.end());
+    indexedWords.erase(std::unique(indexedWords.begin(), indexedWords.end()), indexedWords.end());
+}
+
+ void GraphBuilder::buildPatternMap(const std::vector<std::string>& words) {
+    prepareWords(words);
+    patternIndex.build(indexedWords);
+}
+
+ std::vector<CompactGraph::Edge> GraphBuilder::collectEdges() const {
+    std::vector<CompactGraph::Edge> edges;
+    patternIndex.forEachBucket([&edges](const CompactGraph::NodeId* first, const CompactGraph::NodeId* last) {
+        for (const CompactGraph::NodeId* a = first; a != last; ++a) {
+            for (const CompactGraph::NodeId* b = a + 1; b != last; ++b) {
+                edges.emplace_back(*a, *b);
+            }
+        }
+    });
+    return edges;
+}
+
+ std::vector<std::vector<CompactGraph::Edge>> GraphBuilder::collectEdgesParallel(unsigned threadCount) const {
+    const size_t n = indexedWords.size();
+    std::vector<std::vector<std::vector<PatternEntry>>> shards(threadCount,
+        std::vector<std::vector<PatternEntry>>(threadCount));
+    const std::vector<unsigned char> stringKeyed = PatternIndex::stringKeyedWords(indexedWords);
+
+    // Phase 1: every thread packs a slice of the words and routes each pattern to a shard.
+    runOnThreads(threadCount, [&](unsigned t) {
+        const size_t first = n * t / threadCount;
+        const size_t last = n * (t + 1) / threadCount;
+        auto& outgoing = shards[t];
+        for (size_t id = first; id < last; ++id) {
+            if (stringKeyed[id]) continue;
+            std::uint64_t code;
+            PackedWord::pack(indexedWords[id].data(), indexedWords[id].size(), code);
+            for (size_t i = 0; i < indexedWords[id].length(); ++i) {
+                std::uint64_t key = PackedWord::withWildcard(code, i);
+                size_t shard = static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) % threadCount;
+                outgoing[shard].push_back({ key, static_cast<CompactGraph::NodeId>(id) });
+            }
+        }
+    });
+
+    // Phase 2: every thread owns one shard, groups it by key and emits its own edges.
+    std::vector<std::vector<CompactGraph::Edge>> edgeLists(threadCount + 1);
+    runOnThreads(threadCount, [&](unsigned s) {
+        std::vector<PatternEntry> entries;
+        for (unsigned t = 0; t < threadCount; ++t) {
+            entries.insert(entries.end(), shards[t][s].begin(), shards[t][s].end());
+            std::vector<PatternEntry>().swap(shards[t][s]);
+        }
+        std::sort(entries.begin(), entries.end());
 
-    std::string word;
-    while (file >> word) {
+        auto& edges = edgeLists[s];
+        for (size_t runStart = 0; runStart < entries.size();) {
+            size_t runEnd = runStart + 1;
+            while (runEnd < entries.size() && entries[runEnd].key == entries[runStart].key) ++runEnd;
+            for (size_t a = runStart; a < runEnd; ++a) {
+                for (size_t b = a + 1; b < runEnd; ++b) {
+                    edges.emplace_back(entries[a].id, entries[b].id);
+                }
+            }
+            runStart = runEnd;
+        }
+    });
+
+    appendStringPatternEdges(indexedWords, stringKeyed, edgeLists[threadCount]);
+    return edgeLists;
+}
+
+ std::vector<std::string> GraphBuilder::loadDictionary(const std::string& filename, size_t wordLength) {
+    MappedDictionary dictionary(filename);
+
+    std::vector<std::string> words;
+    for (std::string_view word : dictionary.getWords()) {
         if (wordLength == 0 || word.length() == wordLength) {
-            // Convert to uppercase for consistency
-            std::transform(word.begin(), word.end(), word.begin(), ::toupper);
-            words.push_back(word);
+            words.emplace_back(word);
         }
     }
     return words;
@@ -36,14 +157,420 @@
     buildPatternMap(words);
     Graph<std::string> graph;
 
-    for (const auto& pair : patternMap) {
-        const auto& wordSet = pair.second;
-        for (auto it1 = wordSet.begin(); it1 != wordSet.end(); ++it1) {
-            for (auto it2 = std::next(it1); it2 != wordSet.end(); ++it2) {
-                graph.addEdge(*it1, *it2);
+    for (const auto& edge : collectEdges()) {
+        graph.addEdge(std::string(indexedWords[edge.first]), std::string(indexedWords[edge.second]));
+    }
+
+    return graph;
+}
+
+ CompactGraph GraphBuilder::buildCompactGraph(const std::vector<std::string>& words) {
+    buildPatternMap(words);
+    return CompactGraph(indexedWords, collectEdges());
+}
+
+ CompactGraph GraphBuilder::buildCompactGraph(std::shared_ptr<const DictionaryIndex> dictionary, size_t length) {
+    const size_t n = dictionary->wordCount(length);
+    if (n == 0) return CompactGraph();
+
+    // The bucket is already sorted and unique, so its positions serve as IDs directly.
+    indexedWords.clear();
+    indexedWords.reserve(n);
+    for (size_t i = 0; i < n; ++i) indexedWords.push_back(dictionary->word(length, i));
+    patternIndex.build(indexedWords);
+
+    const std::vector<CompactGraph::Edge> edges = collectEdges();
+    const char* wordChars = indexedWords.front().data();
+    return CompactGraph::fromWordBlock(std::move(dictionary), wordChars, length, n, { &edges });
+}
+
+ Graph<std::string> GraphBuilder::buildGraphParallel(const std::vector<std::string>& words, unsigned threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    prepareWords(words);
+    patternIndex.clear();
+
+    Graph<std::string> graph;
+    for (const auto& edges : collectEdgesParallel(threadCount)) {
+        for (const auto& edge : edges) {
+            graph.addEdge(std::string(indexedWords[edge.first]), std::string(indexedWords[edge.second]));
+        }
+    }
+    return graph;
+}
+
+ CompactGraph GraphBuilder::buildCompactGraphParallel(const std::vector<std::string>& words, unsigned threadCount) {
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    prepareWords(words);
+    patternIndex.clear();
+
+    return CompactGraph(indexedWords, collectEdgesParallel(threadCount));
+}
+
+ CompactGraph GraphBuilder::buildCompactGraphPacked(const std::vector<std::string>& words) {
+    prepareWords(words);
+    patternIndex.clear();
+
+    const size_t n = indexedWords.size();
+    std::vector<std::uint64_t> codes(n, 0);
+    const std::vector<unsigned char> stringKeyed = PatternIndex::stringKeyedWords(indexedWords);
+    std::vector<std::vector<CompactGraph::NodeId>> byLength(PackedWord::MaxLength + 1);
+    for (size_t id = 0; id < n; ++id) {
+        if (stringKeyed[id]) continue;
+        PackedWord::pack(indexedWords[id].data(), indexedWords[id].size(), codes[id]);
+        byLength[indexedWords[id].length()].push_back(static_cast<CompactGraph::NodeId>(id));
+    }
+
+    std::vector<CompactGraph::Edge> edges;
+    std::vector<PatternEntry> blocks;
+    std::vector<std::uint64_t> blockCodes;
+    std::vector<std::uint32_t> matches;
+
+    for (size_t length = 1; length <= PackedWord::MaxLength; ++length) {
+        const auto& ids = byLength[length];
+        if (ids.size() < 2) continue;
+
+        // Words one letter apart share either their prefix or their suffix, never both.
+        const size_t prefixBits = PackedWord::BitsPerLetter * (length - length / 2);
+        const std::uint64_t prefixMask = (std::uint64_t(1) << prefixBits) - 1;
+
+        for (int pass = 0; pass < 2; ++pass) {
+            blocks.clear();
+            for (CompactGraph::NodeId id : ids) {
+                std::uint64_t blockKey = pass == 0 ? codes[id] & prefixMask : codes[id] >> prefixBits;
+                blocks.push_back({ blockKey, id });
+            }
+            std::sort(blocks.begin(), blocks.end());
+
+            for (size_t blockStart = 0; blockStart < blocks.size();) {
+                size_t blockEnd = blockStart + 1;
+                while (blockEnd < blocks.size() && blocks[blockEnd].key == blocks[blockStart].key) ++blockEnd;
+
+                blockCodes.clear();
+                for (size_t i = blockStart; i < blockEnd; ++i) blockCodes.push_back(codes[blocks[i].id]);
+
+                for (size_t i = 0; i + 1 < blockCodes.size(); ++i) {
+                    matches.clear();
+                    PackedWord::findOneLetterMatches(blockCodes[i], blockCodes.data() + i + 1,
+                        blockCodes.size() - i - 1, matches);
+                    for (std::uint32_t match : matches) {
+                        edges.emplace_back(blocks[blockStart + i].id, blocks[blockStart + i + 1 + match].id);
+                    }
+                }
+                blockStart = blockEnd;
             }
         }
     }
 
-    return graph;
+    appendStringPatternEdges(indexedWords, stringKeyed, edges);
+    return CompactGraph(indexedWords, edges);
+}
+
+ size_t GraphBuilder::getPatternIndexMemory() const {
+    return patternIndex.memoryUsage();
+}
+
+ template <typename Fn>
+ void GraphBuilder::forEachEditableBucket(const std::string& word, Fn&& fn) {
+    auto visit = [&fn](auto& buckets, const auto& key) {
+        auto& bucket = buckets[key];
+        fn(bucket);
+        if (bucket.empty()) buckets.erase(key);
+    };
+    std::uint64_t code;
+    if (PackedWord::pack(word, code)) {
+        for (size_t i = 0; i < word.length(); ++i) {
+            visit(editablePatterns, PackedWord::withWildcard(code, i));
+        }
+        return;
+    }
+    std::string pattern = word;
+    for (size_t i = 0; i < pattern.length(); ++i) {
+        char letter = pattern[i];
+        pattern[i] = '*';
+        visit(editableStringPatterns, pattern);
+        pattern[i] = letter;
+    }
+}
+
+ template <typename Fn>
+ void GraphBuilder::forEachCrossBucket(const std::string& word, Fn&& fn) const {
+    std::uint64_t code;
+    if (PackedWord::pack(word, code)) {
+        if (editableStringPatterns.empty()) return;
+        std::string pattern = word;
+        for (size_t i = 0; i < pattern.length(); ++i) {
+            char letter = pattern[i];
+            pattern[i] = '*';
+            auto found = editableStringPatterns.find(pattern);
+            if (found != editableStringPatterns.end()) fn(found->second);
+            pattern[i] = letter;
+        }
+        return;
+    }
+    std::string probe = word;
+    for (size_t i = 0; i < probe.length(); ++i) {
+        char letter = probe[i];
+        if (letter < 'A' || letter > 'Z') {
+            probe[i] = 'A';
+            if (PackedWord::pack(probe, code)) {
+                auto found = editablePatterns.find(PackedWord::withWildcard(code, i));
+                if (found != editablePatterns.end()) fn(found->second);
+            }
+            probe[i] = letter;
+        }
+    }
+}
+
+ std::uint32_t GraphBuilder::newComponent() {
+    if (!freeComponents.empty()) {
+        std::uint32_t label = freeComponents.back();
+        freeComponents.pop_back();
+        return label;
+    }
+    componentSizes.push_back(0);
+    return static_cast<std::uint32_t>(componentSizes.size() - 1);
+}
+
+ std::uint32_t GraphBuilder::relabelComponent(CompactGraph::NodeId start, std::uint32_t from, std::uint32_t to) {
+    std::vector<CompactGraph::NodeId> queue = { start };
+    editableNodes[start].component = to;
+    for (size_t head = 0; head < queue.size(); ++head) {
+        for (CompactGraph::NodeId neighbor : editableNodes[queue[head]].neighbors) {
+            if (editableNodes[neighbor].component == from) {
+                editableNodes[neighbor].component = to;
+                queue.push_back(neighbor);
+            }
+        }
+    }
+    return static_cast<std::uint32_t>(queue.size());
+}
+
+ void GraphBuilder::beginEditing(const std::vector<std::string>& words) {
+    editableNodes.clear();
+    freeNodes.clear();
+    editableIds.clear();
+    editablePatterns.clear();
+    editableStringPatterns.clear();
+    componentSizes.clear();
+    freeComponents.clear();
+
+    editableIds.reserve(words.size());
+    for (const std::string& word : words) {
+        addWord(word);
+    }
+}
+
+ bool GraphBuilder::addWord(const std::string& word) {
+    if (word.empty() || editableIds.count(word) != 0) return false;
+
+    CompactGraph::NodeId id;
+    if (!freeNodes.empty()) {
+        id = freeNodes.back();
+        freeNodes.pop_back();
+    }
+    else {
+        id = static_cast<CompactGraph::NodeId>(editableNodes.size());
+        editableNodes.emplace_back();
+    }
+    editableNodes[id].word = word;
+    editableIds.emplace(editableNodes[id].word, id);
+
+    // Two words one letter apart share exactly one pattern, so no neighbor is found twice.
+    std::vector<CompactGraph::NodeId> neighbors;
+    forEachCrossBucket(word, [&](const std::vector<CompactGraph::NodeId>& bucket) {
+        neighbors.insert(neighbors.end(), bucket.begin(), bucket.end());
+    });
+    forEachEditableBucket(word, [&](std::vector<CompactGraph::NodeId>& bucket) {
+        neighbors.insert(neighbors.end(), bucket.begin(), bucket.end());
+        bucket.insert(std::lower_bound(bucket.begin(), bucket.end(), id), id);
+    });
+    std::sort(neighbors.begin(), neighbors.end());
+    for (CompactGraph::NodeId neighbor : neighbors) {
+        auto& list = editableNodes[neighbor].neighbors;
+        list.insert(std::lower_bound(list.begin(), list.end(), id), id);
+    }
+
+    // Join the new word to the largest adjacent component and pull the others into it.
+    std::uint32_t label = CompactGraph::InvalidId;
+    for (CompactGraph::NodeId neighbor : neighbors) {
+        const std::uint32_t other = editableNodes[neighbor].component;
+        if (label == CompactGraph::InvalidId || componentSizes[other] > componentSizes[label]) label = other;
+    }
+    if (label == CompactGraph::InvalidId) label = newComponent();
+
+    EditableNode& node = editableNodes[id];
+    node.neighbors = std::move(neighbors);
+    node.component = label;
+    componentSizes[label]++;
+    for (CompactGraph::NodeId neighbor : editableNodes[id].neighbors) {
+        const std::uint32_t other = editableNodes[neighbor].component;
+        if (other == label) continue;
+        componentSizes[label] += relabelComponent(neighbor, other, label);
+        componentSizes[other] = 0;
+        freeComponents.push_back(other);
+    }
+    return true;
+}
+
+ bool GraphBuilder::removeWord(const std::string& word) {
+    auto found = editableIds.find(word);
+    if (found == editableIds.end()) return false;
+    const CompactGraph::NodeId id = found->second;
+    editableIds.erase(found);
+
+    forEachEditableBucket(word, [id](std::vector<CompactGraph::NodeId>& bucket) {
+        bucket.erase(std::lower_bound(bucket.begin(), bucket.end(), id));
+    });
+
+    EditableNode& node = editableNodes[id];
+    std::vector<CompactGraph::NodeId> neighbors = std::move(node.neighbors);
+    const std::uint32_t label = node.component;
+    node = EditableNode();
+    freeNodes.push_back(id);
+    for (CompactGraph::NodeId neighbor : neighbors) {
+        auto& list = editableNodes[neighbor].neighbors;
+        list.erase(std::lower_bound(list.begin(), list.end(), id));
+    }
+
+    // Removing an isolated word or a leaf cannot disconnect the rest of its component.
+    componentSizes[label]--;
+    if (neighbors.size() >= 2) splitComponent(word, neighbors, label);
+    if (componentSizes[label] == 0) freeComponents.push_back(label);
+    return true;
+}
+
+ void GraphBuilder::splitComponent(const std::string& removed, const std::vector<CompactGraph::NodeId>& neighbors,
+    std::uint32_t label) {
+    // Neighbors that differ from the removed word in the same position share a pattern
+    // bucket and are therefore linked to each other; one of them stands for all.
+    std::vector<CompactGraph::NodeId> seeds;
+    std::vector<bool> positionSeen(removed.length(), false);
+    for (CompactGraph::NodeId neighbor : neighbors) {
+        const std::string& word = editableNodes[neighbor].word;
+        const size_t position = std::mismatch(removed.begin(), removed.end(), word.begin()).first - removed.begin();
+        if (!positionSeen[position]) {
+            positionSeen[position] = true;
+            seeds.push_back(neighbor);
+        }
+    }
+    if (seeds.size() < 2) return;
+
+    // One search per seed, advanced in turn. Searches that meet are merged; a search that
+    // runs out of words before meeting the others has found a part that split off, so
+    // the work stays proportional to the smaller parts rather than the whole component.
+    struct Search {
+        std::vector<CompactGraph::NodeId> visited; ///< Words reached, including pending ones.
+        std::vector<CompactGraph::NodeId> pending; ///< Words still to expand.
+        size_t parent;                             ///< Search this one was merged into, or itself.
+        bool finished = false;                     ///< Whether the search became its own component.
+    };
+    std::vector<Search> searches(seeds.size());
+    std::unordered_map<CompactGraph::NodeId, size_t> owner;
+    for (size_t i = 0; i < seeds.size(); ++i) {
+        searches[i].visited = { seeds[i] };
+        searches[i].pending = { seeds[i] };
+        searches[i].parent = i;
+        owner.emplace(seeds[i], i);
+    }
+    auto root = [&searches](size_t i) {
+        while (searches[i].parent != i) i = searches[i].parent = searches[searches[i].parent].parent;
+        return i;
+    };
+
+    size_t active = seeds.size();
+    while (active > 1) {
+        for (size_t i = 0; i < searches.size() && active > 1; ++i) {
+            if (root(i) != i || searches[i].finished) continue;
+            if (searches[i].pending.empty()) {
+                const std::uint32_t part = newComponent();
+                for (CompactGraph::NodeId id : searches[i].visited) editableNodes[id].component = part;
+                componentSizes[part] = static_cast<std::uint32_t>(searches[i].visited.size());
+                componentSizes[label] -= componentSizes[part];
+                searches[i].finished = true;
+                --active;
+                continue;
+            }
+
+            const CompactGraph::NodeId current = searches[i].pending.back();
+            searches[i].pending.pop_back();
+            for (CompactGraph::NodeId neighbor : editableNodes[current].neighbors) {
+                size_t mine = root(i);
+                auto inserted = owner.emplace(neighbor, mine);
+                if (inserted.second) {
+                    searches[mine].visited.push_back(neighbor);
+                    searches[mine].pending.push_back(neighbor);
+                    continue;
+                }
+                size_t theirs = root(inserted.first->second);
+                if (theirs == mine) continue;
+                if (searches[mine].visited.size() < searches[theirs].visited.size()) std::swap(mine, theirs);
+                Search& into = searches[mine];
+                Search& from = searches[theirs];
+                into.visited.insert(into.visited.end(), from.visited.begin(), from.visited.end());
+                into.pending.insert(into.pending.end(), from.pending.begin(), from.pending.end());
+                std::vector<CompactGraph::NodeId>().swap(from.visited);
+                std::vector<CompactGraph::NodeId>().swap(from.pending);
+                from.parent = mine;
+                if (--active == 1) break;
+            }
+        }
+    }
+}
+
+ bool GraphBuilder::hasWord(const std::string& word) const {
+    return editableIds.count(word) != 0;
+}
+
+ CompactGraph GraphBuilder::editedGraph() const {
+    struct EditedArrays {
+        std::vector<std::uint32_t> nodeOffsets;
+        std::vector<CompactGraph::NodeId> neighborIds;
+        std::vector<std::uint32_t> wordOffsets;
+        std::vector<char> wordChars;
+        std::vector<std::uint32_t> componentIds;
+        std::vector<std::uint32_t> componentSizes;
+    };
+
+    std::vector<CompactGraph::NodeId> order;
+    order.reserve(editableIds.size());
+    for (const auto& entry : editableIds) order.push_back(entry.second);
+    std::sort(order.begin(), order.end(), [this](CompactGraph::NodeId a, CompactGraph::NodeId b) {
+        return editableNodes[a].word < editableNodes[b].word;
+    });
+    const size_t n = order.size();
+    std::vector<CompactGraph::NodeId> rank(editableNodes.size(), CompactGraph::InvalidId);
+    for (size_t i = 0; i < n; ++i) rank[order[i]] = static_cast<CompactGraph::NodeId>(i);
+
+    auto arrays = std::make_shared<EditedArrays>();
+    arrays->nodeOffsets.reserve(n + 1);
+    arrays->wordOffsets.reserve(n + 1);
+    arrays->nodeOffsets.push_back(0);
+    arrays->wordOffsets.push_back(0);
+    arrays->componentIds.reserve(n);
+    // Labels are renumbered in order of each component's smallest word, as CompactGraph numbers them.
+    std::vector<std::uint32_t> labelOf(componentSizes.size(), CompactGraph::InvalidId);
+    for (CompactGraph::NodeId id : order) {
+        const EditableNode& node = editableNodes[id];
+        const size_t first = arrays->neighborIds.size();
+        for (CompactGraph::NodeId neighbor : node.neighbors) arrays->neighborIds.push_back(rank[neighbor]);
+        std::sort(arrays->neighborIds.begin() + first, arrays->neighborIds.end());
+        arrays->nodeOffsets.push_back(static_cast<std::uint32_t>(arrays->neighborIds.size()));
+
+        arrays->wordChars.insert(arrays->wordChars.end(), node.word.begin(), node.word.end());
+        arrays->wordOffsets.push_back(static_cast<std::uint32_t>(arrays->wordChars.size()));
+
+        std::uint32_t& label = labelOf[node.component];
+        if (label == CompactGraph::InvalidId) {
+            label = static_cast<std::uint32_t>(arrays->componentSizes.size());
+            arrays->componentSizes.push_back(componentSizes[node.component]);
+        }
+        arrays->componentIds.push_back(label);
+    }
+
+    const EditedArrays& built = *arrays;
+    return CompactGraph::fromMemory(std::move(arrays), n, built.nodeOffsets.data(), built.neighborIds.data(),
+        built.wordOffsets.data(), built.wordChars.data(), built.componentIds.data(), built.componentSizes.data(),
+        built.componentSizes.size());
 }
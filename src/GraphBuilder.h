@@ -1,11 +1,16 @@
 #pragma once
 
 #include "Graph.h"
+#include "CompactGraph.h"
+#include "PatternIndex.h"
+#include <cstdint>
+#include <deque>
+#include <memory>
 #include <vector>
 #include <string>
-#include <map>
-#include <set>
-#include <fstream>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
 #include <stdexcept>
 
 /**
@@ -15,32 +20,141 @@
  *
  * This class constructs a graph where nodes are words and edges connect words that differ by one character.
  * It uses intermediate pattern mapping to efficiently determine valid connections.
+ *
+ * Batch builds never copy word text: they refer to the caller's words by string_view and
+ * to each other by 32-bit ID. Built from a DictionaryIndex, the resulting CompactGraph
+ * also borrows the index's word block, so each word is stored exactly once.
+ *
+ * For dictionaries that are edited at runtime, beginEditing() builds a mutable pattern
+ * index and adjacency that stay alive between calls. The editing session owns one copy
+ * of each word, which its word-to-ID map views, and keys patterns like PatternIndex: by
+ * packed 64-bit key, or by string for words that cannot be packed. addWord() and
+ * removeWord() patch only the pattern buckets of the word and the adjacency lists of
+ * its neighbors, in O(L * bucket size), and keep component labels up to date;
+ * editedGraph() freezes the result into a CompactGraph without matching any patterns again.
  */
 
+class DictionaryIndex;
+
 class GraphBuilder {
 private:
     /**
-     * @brief A map from word patterns to sets of words matching that pattern.
+     * @brief An index from word patterns to the IDs of words matching that pattern.
+     *
+     * For example, the pattern "C*T" could map to the IDs of {"CAT", "COT", "CUT"}.
+     */
+    PatternIndex patternIndex;
+
+    /**
+     * @brief The sorted, deduplicated words of the current build. A word's position is its ID.
      *
-     * For example, the pattern "c*t" could map to {"cat", "cot", "cut"}.
+     * The views point into the words passed to the build and are only valid during it.
      */
-    std::map<std::string, std::set<std::string>> patternMap;
+    std::vector<std::string_view> indexedWords;
 
     /**
-     * @brief Constructs the pattern map from the given list of words.
+     * @brief Stores views of the sorted, deduplicated input words in indexedWords.
      *
-     * Each word is transformed into several patterns by replacing each letter with '*', and
-     * those patterns are stored as keys in a map pointing to sets of words that match.
+     * @param words List of words to process.
+     */
+    void prepareWords(const std::vector<std::string>& words);
+
+    /**
+     * @brief Constructs the pattern index from the given list of words.
+     *
+     * The words are sorted and deduplicated into indexedWords, and the index is rebuilt
+     * from scratch, so nothing is carried over from a previous build.
      *
      * @param words List of words to process.
      */
     void buildPatternMap(const std::vector<std::string>& words);
 
+    /**
+     * @brief Expands every pattern bucket into pairwise edges between word IDs.
+     *
+     * @return One entry per pair of words that share a pattern.
+     */
+    std::vector<CompactGraph::Edge> collectEdges() const;
+
+    /**
+     * @brief Finds all edges of indexedWords using several threads.
+     *
+     * Each thread packs a slice of the words and shards its (pattern, ID) pairs by
+     * pattern hash; each thread then sorts one shard and expands its pattern runs into
+     * its own edge list. No locks are taken.
+     *
+     * @param threadCount Number of worker threads (at least 1).
+     * @return One edge list per worker, plus one for words keyed by string pattern.
+     */
+    std::vector<std::vector<CompactGraph::Edge>> collectEdgesParallel(unsigned threadCount) const;
+
+    /**
+     * @brief A word of the editable graph.
+     */
+    struct EditableNode {
+        std::string word;                            ///< The word, empty once removed.
+        std::vector<CompactGraph::NodeId> neighbors; ///< Sorted IDs of the words one letter away.
+        std::uint32_t component = 0;                 ///< Component label.
+    };
+
+    /// Words by editing ID; IDs of removed words are reused. A deque never moves its
+    /// elements, so editableIds can refer to the words stored here.
+    std::deque<EditableNode> editableNodes;
+    std::vector<CompactGraph::NodeId> freeNodes; ///< IDs of removed words.
+    std::unordered_map<std::string_view, CompactGraph::NodeId> editableIds; ///< Editing ID of every word, viewing its node's text.
+    std::unordered_map<std::uint64_t, std::vector<CompactGraph::NodeId>> editablePatterns; ///< Sorted IDs per packed pattern.
+    std::unordered_map<std::string, std::vector<CompactGraph::NodeId>> editableStringPatterns; ///< Same for unpackable words.
+    std::vector<std::uint32_t> componentSizes;   ///< Words per component label, 0 for unused labels.
+    std::vector<std::uint32_t> freeComponents;   ///< Unused component labels.
+
+    /**
+     * @brief Calls fn(bucket) for the pattern bucket of every letter position of a word.
+     *
+     * Buckets are created on first use and dropped once they are empty.
+     */
+    template <typename Fn>
+    void forEachEditableBucket(const std::string& word, Fn&& fn);
+
+    /**
+     * @brief Calls fn(bucket) for every existing bucket of the other key space that may hold
+     * a neighbor of the word.
+     *
+     * A packable word looks up its string patterns, which only unpackable words fill. An
+     * unpackable word with a single character outside 'A'-'Z' looks up the packed pattern
+     * of that position, so "B2B" finds "BOB" and the other way round.
+     */
+    template <typename Fn>
+    void forEachCrossBucket(const std::string& word, Fn&& fn) const;
+
+    /**
+     * @brief Returns an unused component label with a size of 0.
+     */
+    std::uint32_t newComponent();
+
+    /**
+     * @brief Moves every word reachable from start that carries label from to label to.
+     *
+     * @return The number of words relabelled.
+     */
+    std::uint32_t relabelComponent(CompactGraph::NodeId start, std::uint32_t from, std::uint32_t to);
+
+    /**
+     * @brief Gives every part of a component that a removed word split off a label of its own.
+     *
+     * @param removed The removed word.
+     * @param neighbors Its former neighbors, all still labelled with label.
+     * @param label Component label of the removed word; the part still holding it keeps it.
+     */
+    void splitComponent(const std::string& removed, const std::vector<CompactGraph::NodeId>& neighbors,
+        std::uint32_t label);
+
 public:
     /**
      * @brief Loads a dictionary from a file.
      *
-     * Reads a list of words from the specified file, filtering by word length if provided.
+     * Reads a list of words from the specified file through MappedDictionary, filtering by
+     * word length if provided. Words are upper-cased; tokens containing anything other than
+     * letters and repeated words are skipped.
      *
      * @param filename Path to the dictionary file.
      * @param wordLength Optional word length to filter the words. If 0, no filtering is applied.
@@ -58,4 +172,123 @@ public:
      * @return A Graph object with connections based on one-letter differences.
      */
     Graph<std::string> buildGraph(const std::vector<std::string>& words);
+
+    /**
+     * @brief Builds a frozen, integer-ID word graph from the given list of words.
+     *
+     * Words are deduplicated and sorted, and each word's position becomes its ID.
+     * Unlike buildGraph(), words without any neighbor are kept as isolated nodes.
+     *
+     * @param words List of words to include as nodes in the graph.
+     * @return A CompactGraph with connections based on one-letter differences.
+     */
+    CompactGraph buildCompactGraph(const std::vector<std::string>& words);
+
+    /**
+     * @brief Builds the frozen word graph of one length of a dictionary index.
+     *
+     * Node IDs equal the words' positions in the index's bucket, and the graph borrows the
+     * bucket's characters instead of copying them.
+     *
+     * @param dictionary The index holding the words.
+     * @param length Word length to build the graph for.
+     * @return A CompactGraph with connections based on one-letter differences.
+     */
+    CompactGraph buildCompactGraph(std::shared_ptr<const DictionaryIndex> dictionary, size_t length);
+
+    /**
+     * @brief Builds a word graph using several threads.
+     *
+     * Produces exactly the same graph as buildGraph().
+     *
+     * @param words List of words to include as nodes in the graph.
+     * @param threadCount Number of worker threads; 0 uses all hardware threads.
+     * @return A Graph object with connections based on one-letter differences.
+     */
+    Graph<std::string> buildGraphParallel(const std::vector<std::string>& words, unsigned threadCount = 0);
+
+    /**
+     * @brief Builds a frozen, integer-ID word graph using several threads.
+     *
+     * Produces exactly the same graph as buildCompactGraph().
+     *
+     * @param words List of words to include as nodes in the graph.
+     * @param threadCount Number of worker threads; 0 uses all hardware threads.
+     * @return A CompactGraph with connections based on one-letter differences.
+     */
+    CompactGraph buildCompactGraphParallel(const std::vector<std::string>& words, unsigned threadCount = 0);
+
+    /**
+     * @brief Builds a frozen, integer-ID word graph by comparing packed words directly.
+     *
+     * Words are packed five bits per letter and split into length buckets. Two words that
+     * differ in one letter share either their first or their second half, so each bucket
+     * is sorted into prefix blocks and into suffix blocks, and every pair inside a block
+     * is tested with the PackedWord one-letter kernel (AVX2 when available). No pattern
+     * index is built. Produces exactly the same graph as buildCompactGraph().
+     *
+     * @param words List of words to include as nodes in the graph.
+     * @return A CompactGraph with connections based on one-letter differences.
+     */
+    CompactGraph buildCompactGraphPacked(const std::vector<std::string>& words);
+
+    /**
+     * @brief Returns the number of bytes held by the pattern index of the last build.
+     */
+    size_t getPatternIndexMemory() const;
+
+    /**
+     * @brief Starts an editing session on the given words, discarding any previous one.
+     *
+     * @param words The initial words; repeated words are added once.
+     */
+    void beginEditing(const std::vector<std::string>& words);
+
+    /**
+     * @brief Adds a word to the editable graph.
+     *
+     * Links the word to every word one letter away and merges their components, relabelling
+     * the smaller ones.
+     *
+     * @param word The word to add.
+     * @return True if the word was added, false if it is empty or already present.
+     */
+    bool addWord(const std::string& word);
+
+    /**
+     * @brief Removes a word from the editable graph.
+     *
+     * Unlinks the word from its neighbors. If it had neighbors in two or more letter
+     * positions, removing it may split its component; searches from those neighbors run
+     * until they meet, and any part they show to be cut off gets a new label.
+     *
+     * @param word The word to remove.
+     * @return True if the word was removed, false if it was not present.
+     */
+    bool removeWord(const std::string& word);
+
+    /**
+     * @brief Checks whether the editable graph contains a word.
+     */
+    bool hasWord(const std::string& word) const;
+
+    /**
+     * @brief Returns the number of words in the editable graph.
+     */
+    size_t editedWordCount() const { return editableIds.size(); }
+
+    /**
+     * @brief Returns the number of connected components of the editable graph.
+     */
+    size_t editedComponentCount() const { return componentSizes.size() - freeComponents.size(); }
+
+    /**
+     * @brief Freezes the editable graph into a CompactGraph.
+     *
+     * Words are sorted and renumbered, and the maintained component labels are carried
+     * over, so the result equals buildCompactGraph() on the same words.
+     *
+     * @return The frozen graph.
+     */
+    CompactGraph editedGraph() const;
 };
@@ -0,0 +1,344 @@
+#include "GraphCache.h"
+#include "DictionaryIndex.h"
+#include <algorithm>
+#include <exception>
+#include <filesystem>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @brief Size and modification time of a file, both zero if it cannot be read.
+ */
+struct FileStamp {
+    std::uintmax_t size = 0;
+    std::filesystem::file_time_type time{};
+
+    explicit FileStamp(const std::string& path) {
+        std::error_code error;
+        size = std::filesystem::file_size(path, error);
+        if (error) size = 0;
+        time = std::filesystem::last_write_time(path, error);
+        if (error) time = {};
+    }
+
+    bool operator==(const FileStamp& other) const { return size == other.size && time == other.time; }
+    bool operator!=(const FileStamp& other) const { return !(*this == other); }
+};
+
+}
+
+ GraphCache::GraphCache(const std::string& dictionaryPath, const std::string& imagePath, std::size_t memoryBudget)
+    : dictionaryPath(dictionaryPath), imagePath(imagePath), memoryBudget(memoryBudget) {}
+
+ GraphCache::~GraphCache() {
+    stopWatching();
+    stopping = true;
+    wait();
+}
+
+ void GraphCache::prebuild(const std::vector<std::size_t>& lengths, unsigned threadCount) {
+    if (lengths.empty()) return;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(lengths.size()));
+
+    auto queue = std::make_shared<const std::vector<std::size_t>>(lengths);
+    auto next = std::make_shared<std::atomic<std::size_t>>(0);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (unsigned t = 0; t < threadCount; ++t) {
+        workers.emplace_back([this, queue, next]() {
+            while (!stopping) {
+                std::size_t index = next->fetch_add(1);
+                if (index >= queue->size()) break;
+                try {
+                    get((*queue)[index]);
+                }
+                catch (const std::exception&) {
+                    // Left for get() to report when the length is actually needed.
+                }
+            }
+        });
+    }
+}
+
+ void GraphCache::wait() {
+    std::vector<std::thread> running;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running.swap(workers);
+    }
+    for (std::thread& worker : running) {
+        worker.join();
+    }
+}
+
+ std::shared_ptr<const Solver> GraphCache::get(std::size_t length) {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (auto it = entries.find(length); it != entries.end(); it = entries.find(length)) {
+        if (it->second.solver) {
+            it->second.lastUsed = ++useClock;
+            return it->second.solver;
+        }
+        built.wait(lock);
+    }
+
+    // Claim the slot so concurrent callers wait for this build instead of repeating it.
+    entries[length];
+    lock.unlock();
+
+    std::shared_ptr<const GraphSnapshot> source;
+    std::shared_ptr<const Solver> solver;
+    try {
+        source = snapshot();
+        solver = source->buildSolver(length);
+    }
+    catch (...) {
+        lock.lock();
+        entries.erase(length);
+        built.notify_all();
+        throw;
+    }
+
+    lock.lock();
+    if (source != std::atomic_load(&current)) {
+        // A newer snapshot was published meanwhile; waiters rebuild from that one.
+        auto it = entries.find(length);
+        if (it != entries.end() && !it->second.solver) entries.erase(it);
+        built.notify_all();
+        return solver;
+    }
+    Entry& entry = entries[length];
+    if (entry.solver) {
+        // reload() published this snapshot with the length already rebuilt.
+        entry.lastUsed = ++useClock;
+        built.notify_all();
+        return entry.solver;
+    }
+    entry.solver = solver;
+    entry.source = source.get();
+    entry.memory = solver->memoryUsage();
+    entry.lastUsed = ++useClock;
+    memoryUsage += entry.memory;
+    evict();
+    built.notify_all();
+    return solver;
+}
+
+ std::shared_ptr<const DictionaryIndex> GraphCache::getDictionary() {
+    return snapshot()->getDictionary();
+}
+
+ std::shared_ptr<const GraphSnapshot> GraphCache::snapshot() {
+    if (std::shared_ptr<const GraphSnapshot> published = std::atomic_load(&current)) return published;
+    std::lock_guard<std::mutex> opening(sourceMutex);
+    if (std::shared_ptr<const GraphSnapshot> published = std::atomic_load(&current)) return published;
+    std::shared_ptr<const GraphSnapshot> opened = openSnapshot();
+    publish(opened);
+    return opened;
+}
+
+ void GraphCache::publish(std::shared_ptr<const GraphSnapshot> next) {
+    install(std::move(next), {});
+}
+
+ std::shared_ptr<const GraphSnapshot> GraphCache::reload() {
+    // Readers keep being served from the old snapshot while the new one is read and
+    // its solvers are built; they only see it once everything is in place.
+    std::lock_guard<std::mutex> opening(sourceMutex);
+    const Clock::time_point started = Clock::now();
+
+    // Solves are counted by the solvers themselves; the ones cached now keep serving
+    // until the switch, so the growth of their counts is the work done meanwhile.
+    std::vector<std::shared_ptr<const Solver>> serving;
+    std::uint64_t solvesBefore = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& slot : entries) {
+            if (!slot.second.solver) continue;
+            serving.push_back(slot.second.solver);
+            solvesBefore += slot.second.solver->getSolveCount();
+        }
+    }
+
+    std::shared_ptr<const GraphSnapshot> next;
+    std::vector<std::pair<std::size_t, std::shared_ptr<const Solver>>> rebuilt;
+    try {
+        next = openSnapshot();
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (const auto& slot : entries) {
+                if (slot.second.solver) rebuilt.emplace_back(slot.first, nullptr);
+            }
+        }
+
+        // One worker per length, as many as there are cores.
+        const unsigned threadCount = std::min<unsigned>(static_cast<unsigned>(rebuilt.size()),
+            std::max(1u, std::thread::hardware_concurrency()));
+        std::atomic<std::size_t> nextIndex{ 0 };
+        std::vector<std::exception_ptr> errors(rebuilt.size());
+        auto buildAll = [&]() {
+            for (std::size_t i = nextIndex++; i < rebuilt.size(); i = nextIndex++) {
+                try {
+                    rebuilt[i].second = next->buildSolver(rebuilt[i].first);
+                }
+                catch (...) {
+                    errors[i] = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::thread> builders;
+        for (unsigned t = 1; t < threadCount; ++t) builders.emplace_back(buildAll);
+        buildAll();
+        for (std::thread& builder : builders) builder.join();
+        for (const std::exception_ptr& error : errors) {
+            if (error) std::rethrow_exception(error);
+        }
+    }
+    catch (...) {
+        std::lock_guard<std::mutex> lock(mutex);
+        ++reloadStats.failedReloads;
+        throw;
+    }
+
+    install(next, rebuilt);
+    std::uint64_t solved = 0;
+    for (const auto& solver : serving) solved += solver->getSolveCount();
+    solved -= solvesBefore;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ++reloadStats.reloads;
+    reloadStats.lastReloadMilliseconds = std::chrono::duration<double, std::milli>(Clock::now() - started).count();
+    reloadStats.lastSolvedDuringReload = solved;
+    reloadStats.solvedDuringReloads += solved;
+    return next;
+}
+
+ void GraphCache::watch(std::chrono::milliseconds interval, ReloadCallback onReload) {
+    std::lock_guard<std::mutex> control(watchControl);
+    if (watcher.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(watchMutex);
+            watchStopping = true;
+        }
+        watchWake.notify_all();
+        watcher.join();
+    }
+    watchStopping = false;
+    watcher = std::thread(&GraphCache::watchLoop, this, interval, std::move(onReload));
+}
+
+ void GraphCache::stopWatching() {
+    std::lock_guard<std::mutex> control(watchControl);
+    if (!watcher.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(watchMutex);
+        watchStopping = true;
+    }
+    watchWake.notify_all();
+    watcher.join();
+}
+
+ GraphCache::ReloadStats GraphCache::getReloadStats() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return reloadStats;
+}
+
+ std::shared_ptr<const Solver> GraphCache::find(std::size_t length) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = entries.find(length);
+    if (it == entries.end() || !it->second.solver) return nullptr;
+    it->second.lastUsed = ++useClock;
+    return it->second.solver;
+}
+
+ void GraphCache::setMemoryBudget(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    memoryBudget = bytes;
+    evict();
+}
+
+ std::size_t GraphCache::getMemoryBudget() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return memoryBudget;
+}
+
+ std::size_t GraphCache::getMemoryUsage() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return memoryUsage;
+}
+
+ std::shared_ptr<const GraphSnapshot> GraphCache::openSnapshot() {
+    return GraphSnapshot::open(dictionaryPath, imagePath, ++lastVersion);
+}
+
+ void GraphCache::install(std::shared_ptr<const GraphSnapshot> next,
+    const std::vector<std::pair<std::size_t, std::shared_ptr<const Solver>>>& rebuilt) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const GraphSnapshot* source = next.get();
+    std::atomic_store(&current, std::move(next));
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.solver && it->second.source != source) {
+            memoryUsage -= it->second.memory;
+            it = entries.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    // Slots still claimed by a build of the old snapshot are filled here; that build
+    // sees the newer snapshot when it finishes and leaves them alone.
+    for (const auto& solver : rebuilt) {
+        Entry& entry = entries[solver.first];
+        if (entry.solver) continue;
+        entry.solver = solver.second;
+        entry.source = source;
+        entry.memory = solver.second->memoryUsage();
+        entry.lastUsed = ++useClock;
+        memoryUsage += entry.memory;
+    }
+    evict();
+    if (!rebuilt.empty()) built.notify_all();
+}
+
+ void GraphCache::evict() {
+    while (memoryUsage > memoryBudget) {
+        auto victim = entries.end();
+        for (auto it = entries.begin(); it != entries.end(); ++it) {
+            if (it->second.solver && (victim == entries.end() || it->second.lastUsed < victim->second.lastUsed)) {
+                victim = it;
+            }
+        }
+        // The most recent solver is always kept, even if it alone exceeds the budget.
+        if (victim == entries.end() || victim->second.lastUsed == useClock) break;
+        memoryUsage -= victim->second.memory;
+        entries.erase(victim);
+    }
+}
+
+ void GraphCache::watchLoop(std::chrono::milliseconds interval, ReloadCallback onReload) {
+    FileStamp seen(dictionaryPath);
+    FileStamp pending = seen;
+    std::unique_lock<std::mutex> lock(watchMutex);
+    while (!watchWake.wait_for(lock, interval, [this]() { return watchStopping; })) {
+        lock.unlock();
+        const FileStamp stamp(dictionaryPath);
+        if (stamp == seen || stamp != pending) {
+            // Unchanged, or changed since the last check and possibly still being written.
+            pending = stamp;
+        }
+        else {
+            seen = stamp;
+            std::shared_ptr<const GraphSnapshot> next;
+            try {
+                next = reload();
+            }
+            catch (const std::exception&) {
+                // Counted in the reload stats; the old snapshot stays until the file changes again.
+            }
+            if (onReload) onReload(next);
+        }
+        lock.lock();
+    }
+}
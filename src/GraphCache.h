@@ -0,0 +1,250 @@
+#pragma once
+#include "GraphSnapshot.h"
+#include "Solver.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class DictionaryIndex;
+
+/**
+ * @class GraphCache
+ * @brief Keeps one ready-to-use Solver per word length, built on demand or in the background.
+ * @ingroup Core Core Logic
+ *
+ * Solvers are built from the published GraphSnapshot, which holds the dictionary read
+ * once into a DictionaryIndex and, when it is present and up to date, the precompiled
+ * graph image with any hub label index saved next to it. The snapshot's index is
+ * handed out by getDictionary(), so word lists and membership checks never touch the
+ * disk again. prebuild() fills the cache on a pool of worker threads; get() returns a
+ * cached solver immediately, waits for one that is being built, or builds it itself.
+ *
+ * Solvers are handed out as shared pointers to const, so a solver stays valid for as
+ * long as a caller holds it, even after the cache evicts it. When the cached solvers
+ * exceed the memory budget, the least recently used ones are evicted first.
+ *
+ * reload() and publish() replace the snapshot. Solvers of the previous snapshot are
+ * dropped from the cache, but callers holding one keep using that version undisturbed;
+ * builds still running for it finish for their callers and are not cached.
+ *
+ * reload() reads the new snapshot and rebuilds the solvers of every cached length before
+ * publishing, read-copy-update style: until then get() keeps serving the old solvers,
+ * and the switch is a single swap of the snapshot pointer, after which the new solvers
+ * are already in place. watch() runs reload() on a background thread whenever the
+ * dictionary file changes on disk. getReloadStats() reports how long reloads take and
+ * how many ladder queries the solvers cached before a reload answered while it ran.
+ *
+ * All methods are thread-safe.
+ */
+
+class GraphCache {
+public:
+    static constexpr std::size_t DefaultMemoryBudget = std::size_t(256) << 20; ///< 256 MiB.
+    static constexpr std::chrono::milliseconds DefaultWatchInterval{ 1000 };   ///< Dictionary polling period.
+
+    /**
+     * @brief Called by the watcher after each reload with the published snapshot, or nullptr if it failed.
+     */
+    using ReloadCallback = std::function<void(std::shared_ptr<const GraphSnapshot>)>;
+
+    /**
+     * @brief Counters describing the reloads done so far.
+     */
+    struct ReloadStats {
+        std::uint64_t reloads = 0;              ///< Snapshots published by reload().
+        std::uint64_t failedReloads = 0;        ///< Reloads that threw and left the old snapshot in place.
+        double lastReloadMilliseconds = 0;      ///< Time the last successful reload took, rebuilding included.
+        std::uint64_t lastSolvedDuringReload = 0; ///< Ladder queries the old solvers answered while the last reload ran.
+        std::uint64_t solvedDuringReloads = 0;  ///< Ladder queries the old solvers answered while any reload ran.
+    };
+
+    /**
+     * @brief Creates an empty cache for one dictionary.
+     *
+     * @param dictionaryPath Path to the text dictionary.
+     * @param imagePath Path to the precompiled graph image, or empty to always build from text.
+     * @param memoryBudget Bytes the cached solvers may hold before older ones are evicted.
+     */
+    GraphCache(const std::string& dictionaryPath, const std::string& imagePath = "",
+        std::size_t memoryBudget = DefaultMemoryBudget);
+
+    /**
+     * @brief Stops watching, stops prebuilding after the lengths already in progress and
+     *        waits for the workers.
+     */
+    ~GraphCache();
+
+    GraphCache(const GraphCache&) = delete;
+    GraphCache& operator=(const GraphCache&) = delete;
+
+    /**
+     * @brief Starts building solvers for several word lengths in the background.
+     *
+     * Lengths are picked up in the given order by up to threadCount workers. Failures are
+     * not reported here; a later get() for the same length retries and throws.
+     *
+     * @param lengths Word lengths to build, most important first.
+     * @param threadCount Number of worker threads. If 0, hardware concurrency is used.
+     */
+    void prebuild(const std::vector<std::size_t>& lengths, unsigned threadCount = 0);
+
+    /**
+     * @brief Blocks until all background prebuilding has finished.
+     */
+    void wait();
+
+    /**
+     * @brief Returns the solver for a word length, building it if it is not cached.
+     *
+     * @param length Word length.
+     * @return The solver; its graph is empty if the dictionary has no words of that length.
+     * @throws std::runtime_error If the dictionary cannot be read.
+     */
+    std::shared_ptr<const Solver> get(std::size_t length);
+
+    /**
+     * @brief Returns the words of every length of the current snapshot.
+     *
+     * @throws std::runtime_error If the dictionary cannot be read.
+     */
+    std::shared_ptr<const DictionaryIndex> getDictionary();
+
+    /**
+     * @brief Returns the current snapshot, reading the dictionary on first use.
+     *
+     * @throws std::runtime_error If the dictionary cannot be read.
+     */
+    std::shared_ptr<const GraphSnapshot> snapshot();
+
+    /**
+     * @brief Replaces the current snapshot and drops the solvers built from older ones.
+     *
+     * @param next The snapshot to serve from now on.
+     */
+    void publish(std::shared_ptr<const GraphSnapshot> next);
+
+    /**
+     * @brief Reads the dictionary (or graph image) again and publishes it as a new snapshot.
+     *
+     * The solvers of the lengths cached so far are rebuilt from the new snapshot before
+     * it is published, so callers never wait for a build after the switch.
+     *
+     * @return The published snapshot.
+     * @throws std::runtime_error If the dictionary cannot be read; the old snapshot stays.
+     */
+    std::shared_ptr<const GraphSnapshot> reload();
+
+    /**
+     * @brief Starts polling the dictionary file and reloading whenever it changes.
+     *
+     * A change is acted on once the file's size and modification time have stayed the
+     * same for one interval, so a file still being written is not read halfway. Calling
+     * watch() again replaces the previous watcher.
+     *
+     * @param interval Time between two checks of the file.
+     * @param onReload Called on the watcher thread after each reload; must not call stopWatching().
+     */
+    void watch(std::chrono::milliseconds interval = DefaultWatchInterval, ReloadCallback onReload = nullptr);
+
+    /**
+     * @brief Stops the watcher, waiting for a reload it has started to finish.
+     */
+    void stopWatching();
+
+    /**
+     * @brief Returns the reload counters.
+     */
+    ReloadStats getReloadStats() const;
+
+    /**
+     * @brief Returns the solver for a word length only if it is already built.
+     *
+     * @param length Word length.
+     * @return The cached solver, or nullptr if it is missing or still being built.
+     */
+    std::shared_ptr<const Solver> find(std::size_t length);
+
+    /**
+     * @brief Changes the memory budget, evicting solvers if the cache is now over it.
+     */
+    void setMemoryBudget(std::size_t bytes);
+
+    /**
+     * @brief Returns the memory budget in bytes.
+     */
+    std::size_t getMemoryBudget() const;
+
+    /**
+     * @brief Returns the approximate number of bytes held by the cached solvers.
+     */
+    std::size_t getMemoryUsage() const;
+
+private:
+    /**
+     * @brief Cache slot of one word length.
+     */
+    struct Entry {
+        std::shared_ptr<const Solver> solver; ///< The solver, or nullptr while building.
+        const GraphSnapshot* source = nullptr; ///< Snapshot the solver was built from.
+        std::size_t memory = 0;               ///< Bytes reported by the solver.
+        std::uint64_t lastUsed = 0;           ///< Value of useClock at the last lookup.
+    };
+
+    /**
+     * @brief Opens a new snapshot from the dictionary and image paths. Requires sourceMutex.
+     */
+    std::shared_ptr<const GraphSnapshot> openSnapshot();
+
+    /**
+     * @brief Swaps in a snapshot, drops older solvers and caches the ones already built from it.
+     */
+    void install(std::shared_ptr<const GraphSnapshot> next,
+        const std::vector<std::pair<std::size_t, std::shared_ptr<const Solver>>>& rebuilt);
+
+    /**
+     * @brief Evicts least recently used solvers until the budget holds. Requires the lock.
+     */
+    void evict();
+
+    /**
+     * @brief Body of the watcher thread.
+     */
+    void watchLoop(std::chrono::milliseconds interval, ReloadCallback onReload);
+
+    std::string dictionaryPath;  ///< Text dictionary.
+    std::string imagePath;       ///< Precompiled graph image, may be empty.
+
+    mutable std::mutex mutex;                     ///< Guards the members below.
+    std::condition_variable built;                ///< Signalled whenever a build finishes.
+    std::unordered_map<std::size_t, Entry> entries; ///< Slots keyed by word length.
+    std::size_t memoryBudget;                     ///< Eviction threshold in bytes.
+    std::size_t memoryUsage = 0;                  ///< Sum of the memory of all built entries.
+    std::uint64_t useClock = 0;                   ///< Incremented on every lookup.
+    ReloadStats reloadStats;                      ///< Counters returned by getReloadStats().
+
+    /// Published snapshot, null until first use. Read with std::atomic_load without holding
+    /// mutex, so readers never wait for a reload; replaced with std::atomic_store while
+    /// holding it. The atomic shared_ptr functions are not lock-free themselves.
+    std::shared_ptr<const GraphSnapshot> current;
+
+    std::mutex sourceMutex;       ///< Serializes reading snapshots from disk; never waits for mutex's holders.
+    std::uint64_t lastVersion = 0; ///< Version given to the newest snapshot. Guarded by sourceMutex.
+
+    std::mutex watchControl;          ///< Serializes watch() and stopWatching().
+    std::mutex watchMutex;            ///< Guards watchStopping.
+    std::condition_variable watchWake; ///< Wakes the watcher early to stop.
+    bool watchStopping = false;       ///< Asks the watcher to exit.
+    std::thread watcher;              ///< Dictionary polling thread, if watching.
+
+    std::vector<std::thread> workers;   ///< Background prebuild threads.
+    std::atomic<bool> stopping{ false }; ///< Asks workers to stop picking up lengths.
+};
@@ -0,0 +1,276 @@
+#include "GraphImage.h"
+#include "DictionaryIndex.h"
+#include "GraphBuilder.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const char Magic[8] = { 'W', 'L', 'G', 'R', 'A', 'P', 'H', '\0' };
+
+/**
+ * @brief Fixed-size file header at offset 0.
+ */
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t sectionCount;
+    std::uint64_t dictionarySize;
+    std::int64_t dictionaryTime;
+    std::uint64_t checksum;
+    std::uint64_t reserved[3];
+};
+
+/**
+ * @brief Rounds an offset up to the next multiple of eight.
+ */
+std::uint64_t align8(std::uint64_t offset) {
+    return (offset + 7) & ~std::uint64_t(7);
+}
+
+/**
+ * @brief Hashes a byte range eight bytes at a time.
+ */
+std::uint64_t checksum(const char* data, std::size_t size) {
+    std::uint64_t hash = 0x84222325cbf29ce4ull ^ size;
+    std::size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, data + i, 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ull;
+        hash ^= hash >> 32;
+    }
+    for (; i < size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(data[i])) * 0x100000001b3ull;
+    }
+    return hash;
+}
+
+/**
+ * @brief Reads the size and modification time of a file.
+ */
+void fileStamp(const std::string& path, std::uint64_t& size, std::int64_t& time) {
+    std::error_code error;
+    size = static_cast<std::uint64_t>(std::filesystem::file_size(path, error));
+    if (error) size = 0;
+    auto writeTime = std::filesystem::last_write_time(path, error);
+    time = error ? 0 : static_cast<std::int64_t>(writeTime.time_since_epoch().count());
+}
+
+}
+
+/**
+ * @brief Section table entry describing the graph of one word length.
+ */
+struct GraphImage::Section {
+    std::uint32_t wordLength;
+    std::uint32_t nodeCount;
+    std::uint64_t neighborCount;
+    std::uint64_t charCount;
+    std::uint64_t nodeOffsetsAt;
+    std::uint64_t neighborIdsAt;
+    std::uint64_t wordOffsetsAt;
+    std::uint64_t wordCharsAt;
+    std::uint64_t componentCount;
+    std::uint64_t componentIdsAt;
+    std::uint64_t componentSizesAt;
+};
+
+ void GraphImage::compile(const std::string& dictionaryPath, const std::string& imagePath) {
+    Header header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FormatVersion;
+    fileStamp(dictionaryPath, header.dictionarySize, header.dictionaryTime);
+
+    std::shared_ptr<const DictionaryIndex> dictionary = DictionaryIndex::load(dictionaryPath);
+    const std::vector<std::size_t> lengths = dictionary->getWordLengths();
+
+    GraphBuilder builder;
+    std::vector<CompactGraph> graphs;
+    std::vector<Section> sections;
+    std::uint64_t offset = align8(sizeof(Header) + sizeof(Section) * lengths.size());
+    for (std::size_t length : lengths) {
+        graphs.push_back(builder.buildCompactGraph(dictionary, length));
+        const CompactGraph& graph = graphs.back();
+
+        Section section = {};
+        section.wordLength = static_cast<std::uint32_t>(length);
+        section.nodeCount = static_cast<std::uint32_t>(graph.nodeCount());
+        section.neighborCount = graph.getNodeOffsets()[graph.nodeCount()];
+        section.charCount = graph.getWordOffsets()[graph.nodeCount()];
+        section.nodeOffsetsAt = offset;
+        offset = align8(offset + (section.nodeCount + 1) * sizeof(std::uint32_t));
+        section.neighborIdsAt = offset;
+        offset = align8(offset + section.neighborCount * sizeof(CompactGraph::NodeId));
+        section.wordOffsetsAt = offset;
+        offset = align8(offset + (section.nodeCount + 1) * sizeof(std::uint32_t));
+        section.wordCharsAt = offset;
+        offset = align8(offset + section.charCount);
+        section.componentCount = graph.componentCount();
+        section.componentIdsAt = offset;
+        offset = align8(offset + section.nodeCount * sizeof(std::uint32_t));
+        section.componentSizesAt = offset;
+        offset = align8(offset + section.componentCount * sizeof(std::uint32_t));
+        sections.push_back(section);
+    }
+    header.sectionCount = static_cast<std::uint32_t>(sections.size());
+
+    std::vector<char> image(offset, 0);
+    if (!sections.empty()) {
+        std::memcpy(image.data() + sizeof(Header), sections.data(), sizeof(Section) * sections.size());
+    }
+    for (std::size_t i = 0; i < sections.size(); ++i) {
+        const Section& section = sections[i];
+        const CompactGraph& graph = graphs[i];
+        std::memcpy(image.data() + section.nodeOffsetsAt, graph.getNodeOffsets(),
+            (section.nodeCount + 1) * sizeof(std::uint32_t));
+        std::memcpy(image.data() + section.neighborIdsAt, graph.getNeighborIds(),
+            section.neighborCount * sizeof(CompactGraph::NodeId));
+        std::memcpy(image.data() + section.wordOffsetsAt, graph.getWordOffsets(),
+            (section.nodeCount + 1) * sizeof(std::uint32_t));
+        std::memcpy(image.data() + section.wordCharsAt, graph.getWordChars(), section.charCount);
+        std::memcpy(image.data() + section.componentIdsAt, graph.getComponentIds(),
+            section.nodeCount * sizeof(std::uint32_t));
+        std::memcpy(image.data() + section.componentSizesAt, graph.getComponentSizes(),
+            section.componentCount * sizeof(std::uint32_t));
+    }
+    header.checksum = checksum(image.data() + sizeof(Header), image.size() - sizeof(Header));
+    std::memcpy(image.data(), &header, sizeof(Header));
+
+    // Write next to the target and rename, so readers never map a half-written image.
+    const std::string temporaryPath = imagePath + ".tmp";
+    {
+        std::ofstream out(temporaryPath, std::ios::binary | std::ios::trunc);
+        if (!out.write(image.data(), static_cast<std::streamsize>(image.size()))) {
+            throw std::runtime_error("Could not write graph image " + temporaryPath);
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, imagePath, error);
+    if (error) {
+        std::filesystem::remove(temporaryPath, error);
+        throw std::runtime_error("Could not replace graph image " + imagePath);
+    }
+}
+
+ std::shared_ptr<const GraphImage> GraphImage::open(const std::string& imagePath) {
+    auto file = std::make_shared<const MappedFile>(imagePath);
+    const char* data = file->getData();
+    const std::size_t size = file->getSize();
+
+    Header header;
+    if (size < sizeof(Header)) {
+        throw std::runtime_error("Graph image is truncated");
+    }
+    std::memcpy(&header, data, sizeof(Header));
+    if (std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("Not a graph image");
+    }
+    if (header.version != FormatVersion) {
+        throw std::runtime_error("Graph image has an unsupported format version");
+    }
+    if (sizeof(Header) + sizeof(Section) * static_cast<std::uint64_t>(header.sectionCount) > size) {
+        throw std::runtime_error("Graph image is truncated");
+    }
+    if (checksum(data + sizeof(Header), size - sizeof(Header)) != header.checksum) {
+        throw std::runtime_error("Graph image checksum mismatch");
+    }
+
+    std::shared_ptr<GraphImage> image(new GraphImage());
+    image->dictionarySize = header.dictionarySize;
+    image->dictionaryTime = header.dictionaryTime;
+
+    // A section fits when every array lies inside the file, both offset arrays start at
+    // zero and never decrease up to the CSR totals, every word has the section's length,
+    // every neighbor is a node of the section, and the component labels name existing
+    // components whose sizes match the labels. The checksum only catches accidental
+    // damage, so nothing read later through these arrays relies on it.
+    auto fits = [size](std::uint64_t at, std::uint64_t count, std::uint64_t width) {
+        return at <= size && count <= (size - at) / width;
+    };
+    const Section* table = reinterpret_cast<const Section*>(data + sizeof(Header));
+    for (std::uint32_t i = 0; i < header.sectionCount; ++i) {
+        const Section& section = table[i];
+        const std::uint64_t offsetCount = section.nodeCount + std::uint64_t(1);
+        bool valid = (section.nodeOffsetsAt | section.neighborIdsAt | section.wordOffsetsAt
+                | section.componentIdsAt | section.componentSizesAt) % 4 == 0
+            && fits(section.nodeOffsetsAt, offsetCount, sizeof(std::uint32_t))
+            && fits(section.neighborIdsAt, section.neighborCount, sizeof(CompactGraph::NodeId))
+            && fits(section.wordOffsetsAt, offsetCount, sizeof(std::uint32_t))
+            && fits(section.wordCharsAt, section.charCount, 1)
+            && fits(section.componentIdsAt, section.nodeCount, sizeof(std::uint32_t))
+            && fits(section.componentSizesAt, section.componentCount, sizeof(std::uint32_t));
+        if (valid) {
+            const std::uint32_t* nodeOffsets = reinterpret_cast<const std::uint32_t*>(data + section.nodeOffsetsAt);
+            const std::uint32_t* wordOffsets = reinterpret_cast<const std::uint32_t*>(data + section.wordOffsetsAt);
+            valid = nodeOffsets[0] == 0 && wordOffsets[0] == 0
+                && nodeOffsets[section.nodeCount] == section.neighborCount
+                && wordOffsets[section.nodeCount] == section.charCount;
+            for (std::uint32_t id = 0; valid && id < section.nodeCount; ++id) {
+                valid = nodeOffsets[id] <= nodeOffsets[id + 1]
+                    && wordOffsets[id + 1] - wordOffsets[id] == section.wordLength;
+            }
+        }
+        if (valid) {
+            const CompactGraph::NodeId* neighborIds
+                = reinterpret_cast<const CompactGraph::NodeId*>(data + section.neighborIdsAt);
+            for (std::uint64_t i = 0; valid && i < section.neighborCount; ++i) {
+                valid = neighborIds[i] < section.nodeCount;
+            }
+        }
+        if (valid) {
+            const std::uint32_t* componentIds = reinterpret_cast<const std::uint32_t*>(data + section.componentIdsAt);
+            const std::uint32_t* componentSizes
+                = reinterpret_cast<const std::uint32_t*>(data + section.componentSizesAt);
+            std::vector<std::uint32_t> members(static_cast<std::size_t>(section.componentCount), 0);
+            for (std::uint32_t id = 0; valid && id < section.nodeCount; ++id) {
+                valid = componentIds[id] < section.componentCount;
+                if (valid) ++members[componentIds[id]];
+            }
+            for (std::uint64_t c = 0; valid && c < section.componentCount; ++c) {
+                valid = members[c] == componentSizes[c];
+            }
+        }
+        if (!valid) {
+            throw std::runtime_error("Graph image has a corrupt section table");
+        }
+        image->sections.push_back(&section);
+    }
+
+    image->file = std::move(file);
+    return image;
+}
+
+ bool GraphImage::isStale(const std::string& dictionaryPath) const {
+    std::uint64_t size;
+    std::int64_t time;
+    fileStamp(dictionaryPath, size, time);
+    return size != dictionarySize || time != dictionaryTime;
+}
+
+ std::vector<std::size_t> GraphImage::getWordLengths() const {
+    std::vector<std::size_t> lengths;
+    for (const Section* section : sections) {
+        lengths.push_back(section->wordLength);
+    }
+    return lengths;
+}
+
+ CompactGraph GraphImage::getGraph(std::size_t wordLength) const {
+    for (const Section* section : sections) {
+        if (section->wordLength != wordLength) continue;
+        const char* data = file->getData();
+        return CompactGraph::fromMemory(file, section->nodeCount,
+            reinterpret_cast<const std::uint32_t*>(data + section->nodeOffsetsAt),
+            reinterpret_cast<const CompactGraph::NodeId*>(data + section->neighborIdsAt),
+            reinterpret_cast<const std::uint32_t*>(data + section->wordOffsetsAt),
+            data + section->wordCharsAt,
+            reinterpret_cast<const std::uint32_t*>(data + section->componentIdsAt),
+            reinterpret_cast<const std::uint32_t*>(data + section->componentSizesAt),
+            static_cast<std::size_t>(section->componentCount));
+    }
+    return CompactGraph();
+}
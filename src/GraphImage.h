@@ -0,0 +1,88 @@
+#pragma once
+#include "CompactGraph.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class MappedFile;
+
+/**
+ * @class GraphImage
+ * @brief A precompiled, memory-mapped file holding one word graph per word length.
+ * @ingroup Graph Graph Structures
+ *
+ * The image is produced offline by compile() and opened read-only with open(). Each
+ * section stores the word table, CSR adjacency and component labels of one CompactGraph
+ * exactly as they are laid out in memory, so graphs are served straight from the mapping
+ * without parsing or building anything.
+ *
+ * Layout (native byte order, every array 8-byte aligned):
+ * - Header: magic "WLGRAPH", format version, section count, size and modification time
+ *   of the source dictionary, and a 64-bit checksum over everything after the header.
+ * - Section table: one entry per word length with its node and component counts and
+ *   array offsets.
+ * - Array data referenced by the section table.
+ *
+ * The header records the dictionary it was compiled from; isStale() compares that
+ * against the file on disk so callers can fall back to the text path.
+ */
+
+class GraphImage {
+public:
+    static constexpr std::uint32_t FormatVersion = 2; ///< Bumped on every layout change.
+
+    /**
+     * @brief Compiles a dictionary into a graph image file.
+     *
+     * Builds one CompactGraph per word length found in the dictionary and writes them all.
+     *
+     * @param dictionaryPath Path to the text dictionary.
+     * @param imagePath Path of the image file to write.
+     * @throws std::runtime_error If a file cannot be read or written.
+     */
+    static void compile(const std::string& dictionaryPath, const std::string& imagePath);
+
+    /**
+     * @brief Maps an image file and validates its header and checksum.
+     *
+     * @param imagePath Path to the image file.
+     * @return The opened image.
+     * @throws std::runtime_error If the file is missing, truncated, from another format
+     *         version or fails its checksum.
+     */
+    static std::shared_ptr<const GraphImage> open(const std::string& imagePath);
+
+    /**
+     * @brief Checks whether the image was compiled from a different version of a dictionary.
+     *
+     * @param dictionaryPath Path to the text dictionary.
+     * @return True if the dictionary's size or modification time differ from the recorded ones.
+     */
+    bool isStale(const std::string& dictionaryPath) const;
+
+    /**
+     * @brief Returns the word lengths stored in the image, in increasing order.
+     */
+    std::vector<std::size_t> getWordLengths() const;
+
+    /**
+     * @brief Returns the graph for one word length, viewing the mapped file.
+     *
+     * The returned graph keeps the mapping alive on its own.
+     *
+     * @param wordLength Word length to select.
+     * @return The graph, or an empty graph if the image has no words of that length.
+     */
+    CompactGraph getGraph(std::size_t wordLength) const;
+
+private:
+    struct Section;
+
+    GraphImage() = default;
+
+    std::shared_ptr<const MappedFile> file;   ///< The read-only mapping.
+    std::uint64_t dictionarySize = 0;         ///< Size of the source dictionary.
+    std::int64_t dictionaryTime = 0;          ///< Modification time of the source dictionary.
+    std::vector<const Section*> sections;     ///< Section table entries inside the mapping.
+};
@@ -0,0 +1,50 @@
+#include "GraphSnapshot.h"
+#include "DictionaryIndex.h"
+#include "GraphBuilder.h"
+#include "GraphImage.h"
+#include "HubLabelIndex.h"
+
+ GraphSnapshot::GraphSnapshot(std::shared_ptr<const DictionaryIndex> dictionary, std::shared_ptr<const GraphImage> image,
+    std::string imagePath, std::uint64_t version)
+    : dictionary(std::move(dictionary)), image(std::move(image)), imagePath(std::move(imagePath)), version(version) {}
+
+ std::shared_ptr<const GraphSnapshot> GraphSnapshot::open(const std::string& dictionaryPath,
+    const std::string& imagePath, std::uint64_t version) {
+    std::shared_ptr<const GraphImage> image;
+    if (!imagePath.empty()) {
+        try {
+            std::shared_ptr<const GraphImage> opened = GraphImage::open(imagePath);
+            if (!opened->isStale(dictionaryPath)) image = opened;
+        }
+        catch (const std::exception&) {
+            // Missing or invalid images fall back to the text dictionary.
+        }
+    }
+    std::shared_ptr<const DictionaryIndex> dictionary
+        = image ? DictionaryIndex::fromImage(*image) : DictionaryIndex::load(dictionaryPath);
+    return std::make_shared<const GraphSnapshot>(std::move(dictionary), std::move(image), imagePath, version);
+}
+
+ std::shared_ptr<const Solver> GraphSnapshot::buildSolver(std::size_t length) const {
+    CompactGraph graph;
+    if (image) {
+        graph = image->getGraph(length);
+    }
+    else {
+        GraphBuilder builder;
+        graph = builder.buildCompactGraph(dictionary, length);
+    }
+
+    auto solver = std::make_shared<Solver>(graph, dictionary);
+    if (image) {
+        // Hub labels are optional companions of the image; a missing or stale file is skipped.
+        try {
+            solver->setHubLabels(std::make_shared<const HubLabelIndex>(
+                HubLabelIndex::load(HubLabelIndex::companionPath(imagePath, length), solver->getGraph())));
+        }
+        catch (const std::exception&) {
+            // Searches work without labels, only slower.
+        }
+    }
+    return solver;
+}
@@ -0,0 +1,77 @@
+#pragma once
+#include "Solver.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+class DictionaryIndex;
+class GraphImage;
+
+/**
+ * @class GraphSnapshot
+ * @brief One immutable version of the dictionary and the sources of its word graphs.
+ * @ingroup Core Core Logic
+ *
+ * A snapshot holds the DictionaryIndex read from the text dictionary, or the graph
+ * image when that is present and up to date, and builds solvers from it. Snapshots are
+ * shared as pointers to const: the cache, the solvers and any worker thread refer to the
+ * same one, and nothing in it is ever copied or modified.
+ *
+ * Every solver built by a snapshot keeps the data it uses alive on its own, so a caller
+ * may keep searching an old version for as long as it holds the solver, even after a
+ * newer snapshot has been published.
+ */
+
+class GraphSnapshot {
+public:
+    /**
+     * @brief Wraps an already loaded dictionary and, optionally, its graph image.
+     *
+     * @param dictionary Words of every length.
+     * @param image Up-to-date graph image the dictionary was taken from, or nullptr.
+     * @param imagePath Path of the image, used to find its hub label files.
+     * @param version Number identifying this snapshot among those of one cache.
+     */
+    GraphSnapshot(std::shared_ptr<const DictionaryIndex> dictionary, std::shared_ptr<const GraphImage> image = nullptr,
+        std::string imagePath = "", std::uint64_t version = 0);
+
+    /**
+     * @brief Reads a dictionary, preferring its graph image when that is up to date.
+     *
+     * @param dictionaryPath Path to the text dictionary.
+     * @param imagePath Path to the precompiled graph image, or empty to always use the text.
+     * @param version Number identifying the snapshot.
+     * @return The new snapshot.
+     * @throws std::runtime_error If the dictionary cannot be read.
+     */
+    static std::shared_ptr<const GraphSnapshot> open(const std::string& dictionaryPath,
+        const std::string& imagePath, std::uint64_t version);
+
+    /**
+     * @brief Returns the number identifying this snapshot.
+     */
+    std::uint64_t getVersion() const { return version; }
+
+    /**
+     * @brief Returns the words of every length.
+     */
+    const std::shared_ptr<const DictionaryIndex>& getDictionary() const { return dictionary; }
+
+    /**
+     * @brief Builds the solver for one word length.
+     *
+     * Graphs are viewed from the image, with any hub label index saved next to it, or
+     * built from the dictionary index, whose words they borrow.
+     *
+     * @param length Word length.
+     * @return The solver; its graph is empty if there are no words of that length.
+     */
+    std::shared_ptr<const Solver> buildSolver(std::size_t length) const;
+
+private:
+    std::shared_ptr<const DictionaryIndex> dictionary; ///< Words of every length.
+    std::shared_ptr<const GraphImage> image;           ///< Up-to-date graph image, if any.
+    std::string imagePath;                             ///< Path of the image.
+    std::uint64_t version;                             ///< Number identifying the snapshot.
+};
@@ -0,0 +1,220 @@
+#include "HubLabelIndex.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+const char Magic[8] = { 'W', 'L', 'H', 'U', 'B', 'L', 'B', '\0' };
+
+/**
+ * @brief Fixed-size file header at offset 0.
+ */
+struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t reserved;
+    std::uint64_t nodeCount;
+    std::uint64_t entryCount;
+    std::uint64_t graphFingerprint;
+};
+
+template <typename T>
+void writeArray(std::ofstream& out, const std::vector<T>& values) {
+    out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+template <typename T>
+bool readArray(std::ifstream& in, std::vector<T>& values, std::uint64_t count) {
+    values.resize(static_cast<std::size_t>(count));
+    return static_cast<bool>(in.read(reinterpret_cast<char*>(values.data()),
+        static_cast<std::streamsize>(count * sizeof(T))));
+}
+
+}
+
+ HubLabelIndex::HubLabelIndex(const CompactGraph& graph) : graphFingerprint(graph.fingerprint()) {
+    const std::size_t n = graph.nodeCount();
+    const std::uint32_t unreached = CompactGraph::InvalidId;
+
+    // Hubs are numbered by rank: highest degree first, ties broken by ID.
+    std::vector<NodeId> order(n);
+    for (NodeId id = 0; id < n; ++id) order[id] = id;
+    std::stable_sort(order.begin(), order.end(), [&graph](NodeId a, NodeId b) {
+        return graph.degree(a) > graph.degree(b);
+    });
+
+    std::vector<std::vector<std::pair<std::uint32_t, std::uint16_t>>> labels(n);
+    std::vector<std::uint32_t> rootDistance(n, unreached); // Root's label, indexed by hub rank.
+    std::vector<std::uint32_t> depth(n, unreached);
+    std::vector<NodeId> queue;
+    queue.reserve(n);
+
+    for (std::uint32_t rank = 0; rank < n; ++rank) {
+        const NodeId root = order[rank];
+        for (const auto& entry : labels[root]) rootDistance[entry.first] = entry.second;
+
+        queue.clear();
+        queue.push_back(root);
+        depth[root] = 0;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            const NodeId current = queue[head];
+            const std::uint32_t d = depth[current];
+
+            // Prune: existing labels already prove a path of length at most d.
+            bool covered = false;
+            for (const auto& entry : labels[current]) {
+                if (rootDistance[entry.first] != unreached && rootDistance[entry.first] + entry.second <= d) {
+                    covered = true;
+                    break;
+                }
+            }
+            if (covered) continue;
+
+            if (d > std::numeric_limits<std::uint16_t>::max()) {
+                throw std::runtime_error("Graph diameter is too large for a hub label index");
+            }
+            labels[current].emplace_back(rank, static_cast<std::uint16_t>(d));
+            for (const NodeId* it = graph.neighborsBegin(current); it != graph.neighborsEnd(current); ++it) {
+                if (depth[*it] == unreached) {
+                    depth[*it] = d + 1;
+                    queue.push_back(*it);
+                }
+            }
+        }
+
+        for (NodeId visited : queue) depth[visited] = unreached;
+        for (const auto& entry : labels[root]) rootDistance[entry.first] = unreached;
+    }
+
+    labelOffsets.resize(n + 1);
+    labelOffsets[0] = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        labelOffsets[i + 1] = labelOffsets[i] + static_cast<std::uint32_t>(labels[i].size());
+    }
+    labelHubs.reserve(labelOffsets[n]);
+    labelDistances.reserve(labelOffsets[n]);
+    for (auto& label : labels) {
+        for (const auto& entry : label) {
+            labelHubs.push_back(entry.first);
+            labelDistances.push_back(entry.second);
+        }
+        std::vector<std::pair<std::uint32_t, std::uint16_t>>().swap(label);
+    }
+}
+
+ HubLabelIndex HubLabelIndex::load(const std::string& filename, const CompactGraph& graph) {
+    std::ifstream in(filename, std::ios::binary);
+    if (!in.is_open()) {
+        throw std::runtime_error("Could not open file " + filename);
+    }
+
+    Header header;
+    if (!in.read(reinterpret_cast<char*>(&header), sizeof(Header))
+        || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0) {
+        throw std::runtime_error("Not a hub label index: " + filename);
+    }
+    if (header.version != FormatVersion) {
+        throw std::runtime_error("Hub label index has an unsupported format version");
+    }
+    if (header.nodeCount != graph.nodeCount() || header.graphFingerprint != graph.fingerprint()) {
+        throw std::runtime_error("Hub label index does not match the graph");
+    }
+
+    // Check the size up front, so a corrupt count cannot trigger a huge allocation.
+    const std::streamoff arraysStart = in.tellg();
+    in.seekg(0, std::ios::end);
+    const std::uint64_t arrayBytes = static_cast<std::uint64_t>(in.tellg() - arraysStart);
+    in.seekg(arraysStart);
+    if (arrayBytes != (header.nodeCount + 1) * sizeof(std::uint32_t)
+        + header.entryCount * (sizeof(std::uint32_t) + sizeof(std::uint16_t))) {
+        throw std::runtime_error("Hub label index is truncated or corrupt");
+    }
+
+    HubLabelIndex index;
+    index.graphFingerprint = header.graphFingerprint;
+    if (!readArray(in, index.labelOffsets, header.nodeCount + 1)
+        || index.labelOffsets.front() != 0 || index.labelOffsets.back() != header.entryCount
+        || !std::is_sorted(index.labelOffsets.begin(), index.labelOffsets.end())
+        || !readArray(in, index.labelHubs, header.entryCount)
+        || !readArray(in, index.labelDistances, header.entryCount)) {
+        throw std::runtime_error("Hub label index is truncated or corrupt");
+    }
+    return index;
+}
+
+ std::string HubLabelIndex::companionPath(const std::string& imagePath, std::size_t wordLength) {
+    return imagePath + "." + std::to_string(wordLength) + ".hub";
+}
+
+ void HubLabelIndex::save(const std::string& filename) const {
+    Header header = {};
+    std::memcpy(header.magic, Magic, sizeof(Magic));
+    header.version = FormatVersion;
+    header.nodeCount = nodeCount();
+    header.entryCount = entryCount();
+    header.graphFingerprint = graphFingerprint;
+
+    std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    std::vector<std::uint32_t> offsets = labelOffsets.empty() ? std::vector<std::uint32_t>{ 0 } : labelOffsets;
+    writeArray(out, offsets);
+    writeArray(out, labelHubs);
+    writeArray(out, labelDistances);
+    if (!out) {
+        throw std::runtime_error("Could not write hub label index " + filename);
+    }
+}
+
+ std::uint32_t HubLabelIndex::distance(NodeId a, NodeId b) const {
+    if (a >= nodeCount() || b >= nodeCount()) return CompactGraph::InvalidId;
+
+    std::uint32_t i = labelOffsets[a];
+    std::uint32_t j = labelOffsets[b];
+    const std::uint32_t endA = labelOffsets[a + 1];
+    const std::uint32_t endB = labelOffsets[b + 1];
+
+    std::uint32_t best = CompactGraph::InvalidId;
+    while (i < endA && j < endB) {
+        if (labelHubs[i] < labelHubs[j]) {
+            ++i;
+        }
+        else if (labelHubs[i] > labelHubs[j]) {
+            ++j;
+        }
+        else {
+            best = std::min<std::uint32_t>(best, labelDistances[i] + labelDistances[j]);
+            ++i;
+            ++j;
+        }
+    }
+    return best;
+}
+
+ std::vector<HubLabelIndex::NodeId> HubLabelIndex::path(const CompactGraph& graph, NodeId start, NodeId end) const {
+    std::uint32_t remaining = distance(start, end);
+    if (remaining == CompactGraph::InvalidId) return {};
+
+    std::vector<NodeId> result = { start };
+    NodeId current = start;
+    while (remaining > 0) {
+        for (const NodeId* it = graph.neighborsBegin(current); it != graph.neighborsEnd(current); ++it) {
+            if (distance(*it, end) == remaining - 1) {
+                current = *it;
+                break;
+            }
+        }
+        result.push_back(current);
+        --remaining;
+    }
+    return result;
+}
+
+ std::size_t HubLabelIndex::memoryUsage() const {
+    return labelOffsets.size() * sizeof(std::uint32_t)
+        + labelHubs.size() * sizeof(std::uint32_t)
+        + labelDistances.size() * sizeof(std::uint16_t);
+}
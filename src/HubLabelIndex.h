@@ -0,0 +1,110 @@
+#pragma once
+#include "CompactGraph.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class HubLabelIndex
+ * @brief Exact distance oracle for a word graph based on pruned landmark labeling.
+ * @ingroup Graph Graph Structures
+ *
+ * Every word stores a label: a list of (hub, distance) pairs such that any two connected
+ * words share a hub lying on one of their shortest paths. distance() merges the two
+ * labels, which are sorted by hub, and returns the smallest sum of distances.
+ *
+ * Labels are built with the pruned BFS of Akiba, Iwata and Yoshida (2013): words are
+ * processed from highest to lowest degree, and the BFS from each word stops at every
+ * word whose distance the labels built so far already answer. Hubs are identified by
+ * their position in that order, so high-degree words, which lie on many shortest
+ * paths, have small hub numbers and keep most labels short.
+ *
+ * The index is tied to the exact graph it was built from. save() records a fingerprint
+ * of the graph and load() refuses files built for a different one.
+ */
+
+class HubLabelIndex {
+public:
+    using NodeId = CompactGraph::NodeId;
+
+    static constexpr std::uint32_t FormatVersion = 1; ///< Bumped on every file layout change.
+
+    /**
+     * @brief Constructs an empty index.
+     */
+    HubLabelIndex() = default;
+
+    /**
+     * @brief Builds the labels for every word of a graph.
+     *
+     * @param graph The graph to index.
+     */
+    explicit HubLabelIndex(const CompactGraph& graph);
+
+    /**
+     * @brief Loads an index written by save().
+     *
+     * @param filename Path to the index file.
+     * @param graph The graph the index must belong to.
+     * @return The loaded index.
+     * @throws std::runtime_error If the file cannot be read, is malformed, or was built
+     *         for a different graph.
+     */
+    static HubLabelIndex load(const std::string& filename, const CompactGraph& graph);
+
+    /**
+     * @brief Returns the conventional path of the index for one word length of a graph image.
+     *
+     * @param imagePath Path to the graph image.
+     * @param wordLength Word length of the indexed graph.
+     */
+    static std::string companionPath(const std::string& imagePath, std::size_t wordLength);
+
+    /**
+     * @brief Writes the index to a file.
+     *
+     * @param filename Path of the file to write.
+     * @throws std::runtime_error If the file cannot be written.
+     */
+    void save(const std::string& filename) const;
+
+    /**
+     * @brief Returns the exact distance between two words.
+     *
+     * @param a ID of the first word.
+     * @param b ID of the second word.
+     * @return The number of steps, or CompactGraph::InvalidId if no path exists.
+     */
+    std::uint32_t distance(NodeId a, NodeId b) const;
+
+    /**
+     * @brief Reconstructs a shortest path by repeatedly stepping to a neighbor one step closer.
+     *
+     * @param graph The graph the index was built from.
+     * @param start ID of the starting word.
+     * @param end ID of the target word.
+     * @return The IDs along a shortest path, or an empty vector if no path exists.
+     */
+    std::vector<NodeId> path(const CompactGraph& graph, NodeId start, NodeId end) const;
+
+    /**
+     * @brief Returns the number of indexed words.
+     */
+    std::size_t nodeCount() const { return labelOffsets.empty() ? 0 : labelOffsets.size() - 1; }
+
+    /**
+     * @brief Returns the total number of (hub, distance) entries over all labels.
+     */
+    std::size_t entryCount() const { return labelHubs.size(); }
+
+    /**
+     * @brief Returns the approximate number of bytes held by the index.
+     */
+    std::size_t memoryUsage() const;
+
+private:
+    std::uint64_t graphFingerprint = 0;         ///< CompactGraph::fingerprint() of the indexed graph.
+    std::vector<std::uint32_t> labelOffsets;    ///< Start of each word's label (size n + 1).
+    std::vector<std::uint32_t> labelHubs;       ///< Hub ranks, increasing within each label.
+    std::vector<std::uint16_t> labelDistances;  ///< Distance to the hub of the same entry.
+};
@@ -0,0 +1,104 @@
+#include "LadderDag.h"
+#include <unordered_map>
+
+ LadderDag::LadderDag(const CompactGraph& graph, NodeId start, const std::vector<std::uint32_t>& distanceToTarget)
+    : graph(graph) {
+    if (start >= distanceToTarget.size() || distanceToTarget[start] == CompactGraph::InvalidId) return;
+    ladderLength = distanceToTarget[start];
+
+    // Walk only the moves that lower the distance to the target by one.
+    std::unordered_map<NodeId, std::uint32_t> localIndex;
+    localIndex.emplace(start, 0);
+    nodes.push_back(start);
+    for (std::size_t head = 0; head < nodes.size(); ++head) {
+        const NodeId current = nodes[head];
+        const std::uint32_t d = distanceToTarget[current];
+        edgeOffsets.push_back(static_cast<std::uint32_t>(successors.size()));
+        if (d == 0) continue;
+        for (const NodeId* it = graph.neighborsBegin(current); it != graph.neighborsEnd(current); ++it) {
+            if (distanceToTarget[*it] != d - 1) continue;
+            auto inserted = localIndex.emplace(*it, static_cast<std::uint32_t>(nodes.size()));
+            if (inserted.second) nodes.push_back(*it);
+            successors.push_back(inserted.first->second);
+        }
+    }
+    edgeOffsets.push_back(static_cast<std::uint32_t>(successors.size()));
+
+    // Successors always come later in BFS order, so one reverse pass settles every count.
+    ladders.resize(nodes.size());
+    for (std::size_t i = nodes.size(); i-- > 0;) {
+        if (edgeOffsets[i] == edgeOffsets[i + 1]) {
+            ladders[i] = 1;
+            continue;
+        }
+        for (std::uint32_t edge = edgeOffsets[i]; edge < edgeOffsets[i + 1]; ++edge) {
+            ladders[i] += ladders[successors[edge]];
+        }
+    }
+}
+
+ const BigCount& LadderDag::count() const {
+    static const BigCount none;
+    return ladders.empty() ? none : ladders.front();
+}
+
+ std::vector<LadderDag::NodeId> LadderDag::sample(std::mt19937& generator) const {
+    if (empty()) return {};
+
+    // Pick the rank of a ladder, then find it by skipping the ladders of earlier successors.
+    BigCount rank = BigCount::uniformBelow(count(), generator);
+    std::vector<NodeId> ladder = { nodes.front() };
+    std::uint32_t current = 0;
+    while (edgeOffsets[current] < edgeOffsets[current + 1]) {
+        std::uint32_t edge = edgeOffsets[current];
+        while (!(rank < ladders[successors[edge]])) {
+            rank -= ladders[successors[edge]];
+            ++edge;
+        }
+        current = successors[edge];
+        ladder.push_back(nodes[current]);
+    }
+    return ladder;
+}
+
+ std::vector<std::string> LadderDag::words(const std::vector<NodeId>& ladder) const {
+    std::vector<std::string> result;
+    result.reserve(ladder.size());
+    for (NodeId id : ladder) result.push_back(graph.wordOf(id));
+    return result;
+}
+
+ LadderDag::Enumerator::Enumerator(const LadderDag& dag) : dag(dag) {}
+
+ bool LadderDag::Enumerator::next(std::vector<NodeId>& ladder) {
+    if (dag.empty()) return false;
+
+    if (!started) {
+        started = true;
+        stack.assign(1, 0);
+        choice.clear();
+    }
+    else {
+        // Backtrack to the deepest word that still has an untried successor.
+        while (true) {
+            if (choice.empty()) return false;
+            stack.pop_back();
+            const std::uint32_t edge = ++choice.back();
+            if (edge < dag.edgeOffsets[stack.back() + 1]) {
+                stack.push_back(dag.successors[edge]);
+                break;
+            }
+            choice.pop_back();
+        }
+    }
+
+    // Complete the ladder with the first successor at every level.
+    while (dag.edgeOffsets[stack.back()] < dag.edgeOffsets[stack.back() + 1]) {
+        choice.push_back(dag.edgeOffsets[stack.back()]);
+        stack.push_back(dag.successors[choice.back()]);
+    }
+
+    ladder.clear();
+    for (std::uint32_t index : stack) ladder.push_back(dag.nodes[index]);
+    return true;
+}
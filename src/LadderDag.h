@@ -0,0 +1,114 @@
+#pragma once
+#include "BigCount.h"
+#include "CompactGraph.h"
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @class LadderDag
+ * @brief The directed acyclic graph of all optimal ladders between two words.
+ * @ingroup Graph Graph Structures
+ *
+ * Given the BFS distance of every word to the target, a move is optimal exactly when it
+ * lowers that distance by one. The words reachable from the start through such moves
+ * form the shortest-path DAG; every path through it from start to target is an optimal
+ * ladder and vice versa.
+ *
+ * The DAG is stored with local indices in BFS order. A single pass in reverse order counts
+ * the ladders from each DAG word to the target as a BigCount, so counting needs time
+ * linear in the size of the DAG rather than in the number of ladders. The counts also
+ * drive exact uniform sampling, and ladders can be enumerated one at a time in
+ * alphabetical order without materializing them all.
+ */
+
+class LadderDag {
+public:
+    using NodeId = CompactGraph::NodeId;
+
+    /**
+     * @brief Lazily walks through all optimal ladders in alphabetical order.
+     *
+     * The enumerator refers to its DAG, which must outlive it.
+     */
+    class Enumerator {
+    public:
+        /**
+         * @brief Produces the next ladder.
+         *
+         * @param ladder Receives the IDs along the ladder, start first.
+         * @return False once every ladder has been produced.
+         */
+        bool next(std::vector<NodeId>& ladder);
+
+    private:
+        friend class LadderDag;
+        explicit Enumerator(const LadderDag& dag);
+
+        const LadderDag& dag;
+        std::vector<std::uint32_t> stack;   ///< Local index of each word on the current ladder.
+        std::vector<std::uint32_t> choice;  ///< Next successor edge to try at each stack level.
+        bool started = false;               ///< Whether the first ladder was produced.
+    };
+
+    /**
+     * @brief Constructs an empty DAG with no ladders.
+     */
+    LadderDag() = default;
+
+    /**
+     * @brief Builds the DAG of optimal ladders from start to the target of a distance field.
+     *
+     * @param graph The word graph.
+     * @param start ID of the starting word.
+     * @param distanceToTarget Distance from every word to the target, InvalidId where unreachable.
+     */
+    LadderDag(const CompactGraph& graph, NodeId start, const std::vector<std::uint32_t>& distanceToTarget);
+
+    /**
+     * @brief Returns true if there is no ladder.
+     */
+    bool empty() const { return nodes.empty(); }
+
+    /**
+     * @brief Returns the number of moves of every optimal ladder, or 0 if there is none.
+     */
+    std::uint32_t length() const { return ladderLength; }
+
+    /**
+     * @brief Returns the number of distinct optimal ladders.
+     */
+    const BigCount& count() const;
+
+    /**
+     * @brief Returns the number of words that lie on at least one optimal ladder.
+     */
+    std::size_t nodeCount() const { return nodes.size(); }
+
+    /**
+     * @brief Draws one optimal ladder, each with the same probability.
+     *
+     * @param generator Source of randomness.
+     * @return The IDs along the ladder, or an empty vector if there is none.
+     */
+    std::vector<NodeId> sample(std::mt19937& generator) const;
+
+    /**
+     * @brief Returns an enumerator positioned before the first ladder.
+     */
+    Enumerator enumerate() const { return Enumerator(*this); }
+
+    /**
+     * @brief Converts a ladder of IDs to words.
+     */
+    std::vector<std::string> words(const std::vector<NodeId>& ladder) const;
+
+private:
+    CompactGraph graph;                    ///< The word graph, used for word lookups.
+    std::uint32_t ladderLength = 0;        ///< Moves of every ladder.
+    std::vector<NodeId> nodes;             ///< Word ID of each DAG node, in BFS order.
+    std::vector<std::uint32_t> edgeOffsets; ///< Start of each node's successors (size nodes + 1).
+    std::vector<std::uint32_t> successors; ///< Local indices of the successors, in ID order.
+    std::vector<BigCount> ladders;         ///< Ladders from each node to the target.
+};
@@ -1,6 +1,8 @@
 ﻿#include "MainWindow.h"
+#include "DictionaryIndex.h"
 #include "GraphBuilder.h"
 #include "Solver.h"
+#include "WordListModel.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -10,11 +12,14 @@
 #include <QDateTime>
 #include <QRegularExpression>
 #include <QPalette>
+#include <QStatusBar>
+#include <QThread>
 #include <QRandomGenerator>
+#include <map>
 #include <random>
 
 MainWindow::MainWindow(QWidget* parent)
-    : QMainWindow(parent), currentGame(nullptr), solver(nullptr) {
+    : QMainWindow(parent), currentGame(nullptr) {
     setWindowTitle("Word Ladder Game");
     resize(800, 600);
 
@@ -29,11 +34,42 @@ MainWindow::MainWindow(QWidget* parent)
     tabWidget->addTab(playTab, "Play Game");
     tabWidget->addTab(analyticsTab, "Analytics");
 
+    loadProgress = new QProgressBar();
+    loadProgress->setMaximumWidth(200);
+    loadProgress->hide();
+    statusBar()->addPermanentWidget(loadProgress);
+    reloadStatus = new QLabel();
+    statusBar()->addPermanentWidget(reloadStatus);
+    loadPool.setMaxThreadCount(std::max(2, QThread::idealThreadCount()));
+
+    // Build every length either tab offers in the background, the automatic tab's first.
+    std::vector<std::size_t> lengths;
+    for (QComboBox* combo : { wordLengthComboAuto, wordLengthComboPlay }) {
+        for (int i = 0; i < combo->count(); ++i) {
+            std::size_t length = combo->itemText(i).toUInt();
+            if (std::find(lengths.begin(), lengths.end(), length) == lengths.end()) lengths.push_back(length);
+        }
+    }
+    graphCache.reset(new GraphCache(currentDictionaryFile.toStdString(),
+        currentGraphImageFile.toStdString(), graphMemoryBudget));
+    graphCache->prebuild(lengths);
+
+    // Reloads run on the watcher thread; only their outcome is passed to the GUI thread.
+    graphCache->watch(GraphCache::DefaultWatchInterval, [this](std::shared_ptr<const GraphSnapshot> next) {
+        QMetaObject::invokeMethod(this, [this, next]() { onDictionaryReloaded(next); }, Qt::QueuedConnection);
+    });
+
     loadDictionary();
+    loadPlaySolver();
 }
 
 MainWindow::~MainWindow() {
-    delete solver;
+    graphCache->stopWatching();
+    // Outstanding loads drop their results; results already queued die with this object.
+    ++autoLoadGeneration;
+    ++playLoadGeneration;
+    ++analyticsGeneration;
+    loadPool.waitForDone();
     delete currentGame;
 }
 
@@ -46,10 +82,14 @@ void MainWindow::setupAutomaticTab() {
     wordLengthComboAuto->addItems({ "3", "4" });
     formLayout->addRow("Word Length:", wordLengthComboAuto);
 
+    // Both combo boxes list the same words, straight from the shared dictionary index.
+    wordListModel = new WordListModel(this);
     startWordComboAuto = new QComboBox();
+    startWordComboAuto->setModel(wordListModel);
     formLayout->addRow("Start Word:", startWordComboAuto);
 
     targetWordComboAuto = new QComboBox();
+    targetWordComboAuto->setModel(wordListModel);
     formLayout->addRow("Target Word:", targetWordComboAuto);
     layout->addLayout(formLayout);
 
@@ -75,9 +115,17 @@ void MainWindow::setupPlayTab() {
     wordLengthComboPlay = new QComboBox();
     wordLengthComboPlay->addItems({ "3", "4", "5", "6", "7" });
     formLayout->addRow("Word Length:", wordLengthComboPlay);
+
+    difficultyComboPlay = new QComboBox();
+    difficultyComboPlay->addItems({ "Any", "Easy (2-3 moves)", "Medium (4-5 moves)", "Hard (6+ moves)" });
+    formLayout->addRow("Difficulty:", difficultyComboPlay);
     layout->addLayout(formLayout);
+    connect(wordLengthComboPlay, QOverload<int>::of(&QComboBox::currentIndexChanged),
+        this, &MainWindow::onPlayWordLengthChanged);
+    connect(difficultyComboPlay, QOverload<int>::of(&QComboBox::currentIndexChanged),
+        this, &MainWindow::onPlayDifficultyChanged);
 
-    QPushButton* startGameButton = new QPushButton("Start Game");
+    startGameButton = new QPushButton("Start Game");
     layout->addWidget(startGameButton);
     connect(startGameButton, &QPushButton::clicked, this, &MainWindow::onStartPlayingClicked);
 
@@ -149,26 +197,129 @@ void MainWindow::setupAnalyticsTab() {
 }
 
 void MainWindow::loadDictionary() {
-    try {
-        int wordLength = wordLengthComboAuto->currentText().toInt();
-        dictionary = GraphBuilder::loadDictionary(currentDictionaryFile.toStdString(), wordLength);
-
-        startWordComboAuto->clear();
-        targetWordComboAuto->clear();
-        for (const auto& word : dictionary) {
-            startWordComboAuto->addItem(QString::fromStdString(word));
-            targetWordComboAuto->addItem(QString::fromStdString(word));
+    // A load still running for a previous length sees a newer generation and gives up.
+    const unsigned generation = ++autoLoadGeneration;
+    const std::size_t wordLength = wordLengthComboAuto->currentText().toUInt();
+
+    solveButton->setEnabled(false);
+    wordListModel->setWords(nullptr, 0);
+    loadProgress->setRange(0, 0);
+    loadProgress->show();
+    statusBar()->showMessage(QString("Loading %1-letter words...").arg(wordLength));
+
+    loadPool.start([this, generation, wordLength]() {
+        std::shared_ptr<const Solver> loaded;
+        std::shared_ptr<const DictionaryIndex> index;
+        QString error;
+        try {
+            loaded = graphCache->get(wordLength);
+            index = graphCache->getDictionary();
+        }
+        catch (const std::exception& e) {
+            error = e.what();
         }
+        if (autoLoadGeneration != generation) return;
+
+        QMetaObject::invokeMethod(this, [this, generation, wordLength, loaded, index, error]() {
+            if (autoLoadGeneration != generation) return;
+            loadProgress->hide();
+            statusBar()->clearMessage();
+            if (!error.isEmpty()) {
+                // Solve stays usable; clicking it without a solver retries the load.
+                solver.reset();
+                solveButton->setEnabled(true);
+                if (QMessageBox::critical(this, "Error", "Failed to load dictionary: " + error + "\n\nTry again?",
+                        QMessageBox::Retry | QMessageBox::Cancel) == QMessageBox::Retry) {
+                    loadDictionary();
+                }
+                return;
+            }
+
+            wordListModel->setWords(index, wordLength);
+            solver = loaded;
+            solveButton->setEnabled(true);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::loadPlaySolver() {
+    const unsigned generation = ++playLoadGeneration;
+    const std::size_t wordLength = wordLengthComboPlay->currentText().toUInt();
+
+    startGameButton->setEnabled(false);
+    nextGameSolver.reset();
+    puzzlePool.reset();
+
+    loadPool.start([this, generation, wordLength]() {
+        std::shared_ptr<const Solver> loaded;
+        QString error;
+        try {
+            loaded = graphCache->get(wordLength);
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        if (playLoadGeneration != generation) return;
+
+        QMetaObject::invokeMethod(this, [this, generation, loaded, error]() {
+            if (playLoadGeneration != generation) return;
+            if (!error.isEmpty()) {
+                // Start Game stays usable; clicking it without a solver retries the load.
+                startGameButton->setEnabled(true);
+                if (QMessageBox::critical(this, "Error", "Failed to load dictionary: " + error + "\n\nTry again?",
+                        QMessageBox::Retry | QMessageBox::Cancel) == QMessageBox::Retry) {
+                    loadPlaySolver();
+                }
+                return;
+            }
+
+            nextGameSolver = loaded;
+            puzzlePool.reset(new PuzzlePool(loaded, playPuzzleOptions()));
+            startGameButton->setEnabled(true);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::onDictionaryReloaded(std::shared_ptr<const GraphSnapshot> next) {
+    if (!next) {
+        reloadStatus->setText("Dictionary reload failed; using the previous version");
+        return;
+    }
+
+    const GraphCache::ReloadStats stats = graphCache->getReloadStats();
+    reloadStatus->setText(QString("Dictionary v%1 reloaded in %2 ms, %3 ladders solved meanwhile")
+        .arg(next->getVersion())
+        .arg(stats.lastReloadMilliseconds, 0, 'f', 0)
+        .arg(stats.lastSolvedDuringReload));
 
-        GraphBuilder builder;
-        wordGraph = builder.buildGraph(dictionary);
-        delete solver;
-        solver = new Solver(wordGraph);
+    // The solvers were rebuilt before the swap, so these loads finish at once.
+    loadDictionary();
+    loadPlaySolver();
+    if (currentGame) {
+        gameLog->append("The dictionary changed; this game continues with the words it started with.");
     }
-    catch (const std::exception& e) {
-        QMessageBox::critical(this, "Error",
-            QString("Failed to load dictionary: ") + e.what());
+}
+
+PuzzleGenerator::Options MainWindow::playPuzzleOptions() const {
+    PuzzleGenerator::Options options;
+    switch (difficultyComboPlay->currentIndex()) {
+    case 1:
+        options.minDistance = 2;
+        options.maxDistance = 3;
+        break;
+    case 2:
+        options.minDistance = 4;
+        options.maxDistance = 5;
+        break;
+    case 3:
+        options.minDistance = 6;
+        break;
+    default:
+        break;
     }
+    // Leave most cores to the GUI and the graph cache.
+    options.threadCount = 2;
+    return options;
 }
 
 void MainWindow::onWordLengthChanged(int index) {
@@ -176,7 +327,23 @@ void MainWindow::onWordLengthChanged(int index) {
     loadDictionary();
 }
 
+void MainWindow::onPlayWordLengthChanged(int index) {
+    Q_UNUSED(index);
+    loadPlaySolver();
+}
+
+void MainWindow::onPlayDifficultyChanged(int index) {
+    Q_UNUSED(index);
+    if (!nextGameSolver) return;
+    puzzlePool.reset(new PuzzlePool(nextGameSolver, playPuzzleOptions()));
+}
+
 void MainWindow::onSolveClicked() {
+    if (!solver) {
+        loadDictionary();
+        return;
+    }
+
     QString start = startWordComboAuto->currentText();
     QString target = targetWordComboAuto->currentText();
 
@@ -199,6 +366,11 @@ void MainWindow::onSolveClicked() {
 }
 
 void MainWindow::onStartPlayingClicked() {
+    if (!nextGameSolver) {
+        loadPlaySolver();
+        return;
+    }
+
     if (playerNameEdit->text().isEmpty()) {
         QMessageBox::warning(this, "Warning", "Please enter your name");
         return;
@@ -208,30 +380,39 @@ void MainWindow::onStartPlayingClicked() {
         endGame();
     }
 
-    int wordLength = wordLengthComboPlay->currentText().toInt();
-    dictionary = GraphBuilder::loadDictionary(currentDictionaryFile.toStdString(), wordLength);
+    playSolver = nextGameSolver;
 
-    if (dictionary.size() < 2) {
+    std::pair<std::string, std::string> puzzle;
+    PuzzleGenerator::Puzzle generated;
+    if (puzzlePool->tryTake(generated)) {
+        puzzle = { generated.start, generated.target };
+    }
+    else if (puzzlePool->exhausted()) {
+        QMessageBox::warning(this, "Warning", "No puzzles of this difficulty for this word length");
+        return;
+    }
+    else {
+        // The pool is still filling; one puzzle of the chosen difficulty is quick to find.
+        PuzzleGenerator::Options options = playPuzzleOptions();
+        options.count = 1;
+        options.seed = std::random_device()();
+        std::vector<PuzzleGenerator::Puzzle> found = PuzzleGenerator(playSolver).generate(options);
+        if (found.empty()) {
+            QMessageBox::warning(this, "Warning", "No puzzles of this difficulty for this word length");
+            return;
+        }
+        puzzle = { found.front().start, found.front().target };
+    }
+    if (puzzle.first.empty()) {
         QMessageBox::warning(this, "Warning", "Not enough words in dictionary");
         return;
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_int_distribution<> dist(0, static_cast<int>(dictionary.size()) - 1);
-
-    int startIdx, targetIdx;
-    do {
-        startIdx = dist(gen);
-        targetIdx = dist(gen);
-    } while (startIdx == targetIdx ||
-        solver->findShortestPath(dictionary[startIdx], dictionary[targetIdx]).empty());
+    QString startWord = QString::fromStdString(puzzle.first);
+    QString targetWord = QString::fromStdString(puzzle.second);
 
-    QString startWord = QString::fromStdString(dictionary[startIdx]);
-    QString targetWord = QString::fromStdString(dictionary[targetIdx]);
-
-    auto optimalPath = solver->findShortestPath(dictionary[startIdx], dictionary[targetIdx]);
-    int optimalMoves = optimalPath.empty() ? 0 : optimalPath.size() - 1;
+    // Computes the target's distance field, which later hints and checks reuse.
+    int optimalMoves = std::max(0, playSolver->distanceToTarget(puzzle.first, puzzle.second));
 
     currentGame = new GameSession(playerNameEdit->text(), startWord, targetWord, optimalMoves);
     currentGame->addMove(startWord);
@@ -256,33 +437,27 @@ void MainWindow::onMakeMoveClicked() {
         return;
     }
 
-    if (newWord == currentWord) {
+    switch (playSolver->validateMove(currentWord.toStdString(), newWord.toStdString())) {
+    case Solver::MoveCheck::Legal:
+        break;
+    case Solver::MoveCheck::SameWord:
         QMessageBox::warning(this, "Warning", "New word is the same as current word");
         return;
-    }
-
-    int diffCount = 0;
-    if (newWord.length() != currentWord.length()) {
+    case Solver::MoveCheck::LengthMismatch:
         QMessageBox::warning(this, "Warning", "Word length must be the same");
         return;
-    }
-
-    for (int i = 0; i < newWord.length(); ++i) {
-        if (newWord[i] != currentWord[i]) {
-            diffCount++;
-        }
-    }
-
-    if (diffCount != 1) {
+    case Solver::MoveCheck::NotOneLetter:
         QMessageBox::warning(this, "Warning", "You must change exactly one letter");
         return;
-    }
-
-    if (std::find(dictionary.begin(), dictionary.end(), newWord.toStdString()) == dictionary.end()) {
+    case Solver::MoveCheck::NotInDictionary:
+    case Solver::MoveCheck::UnknownCurrent:
         QMessageBox::warning(this, "Warning", "Word not in dictionary");
         return;
     }
 
+    const bool optimal = playSolver->isOptimalMove(currentWord.toStdString(),
+        newWord.toStdString(), currentGame->getTargetWord().toStdString());
+
     currentGame->addMove(newWord);
     wordInput->clear();
     hintLabel->clear();
@@ -293,7 +468,9 @@ void MainWindow::onMakeMoveClicked() {
     }
     else {
         updateGameDisplay();
-        gameLog->append(QString("Moved to: %1").arg(newWord));
+        gameLog->append(optimal
+            ? QString("Moved to: %1").arg(newWord)
+            : QString("Moved to: %1 (off the optimal path)").arg(newWord));
     }
 }
 
@@ -303,7 +480,7 @@ void MainWindow::onHintClicked() {
     QString currentWord = currentGame->getCurrentWord();
     QString targetWord = currentGame->getTargetWord();
 
-    auto hint = solver->getHint(currentWord.toStdString(), targetWord.toStdString());
+    auto hint = playSolver->getHint(currentWord.toStdString(), targetWord.toStdString());
     QString nextWord = QString::fromStdString(hint.first);
     int diffPos = hint.second;
 
@@ -341,18 +518,33 @@ void MainWindow::onHintClicked() {
 void MainWindow::onGiveUpClicked() {
     if (!currentGame) return;
 
-    auto optimalPath = solver->findShortestPath(
+    LadderDag ladders = playSolver->optimalLadders(
         currentGame->getStartWord().toStdString(),
         currentGame->getTargetWord().toStdString());
 
-    if (!optimalPath.empty()) {
-        QStringList optimalPathQt;
-        for (const auto& word : optimalPath) {
-            optimalPathQt << QString::fromStdString(word);
+    if (!ladders.empty()) {
+        // Show a few different ladders, drawn uniformly among all optimal ones.
+        const int maxShown = 3;
+        const bool single = ladders.count() == BigCount(1);
+        gameLog->append(single
+            ? QString("\nOptimal solution:")
+            : QString("\nOptimal solutions (%1 in total):").arg(QString::fromStdString(ladders.count().toString())));
+
+        std::random_device rd;
+        std::mt19937 gen(rd());
+        QStringList shown;
+        for (int attempt = 0; attempt < 4 * maxShown && shown.size() < maxShown; ++attempt) {
+            QStringList optimalPathQt;
+            for (const auto& word : ladders.words(ladders.sample(gen))) {
+                optimalPathQt << QString::fromStdString(word);
+            }
+            QString line = optimalPathQt.join(" → ");
+            if (!shown.contains(line)) {
+                shown << line;
+                gameLog->append(line);
+            }
+            if (single) break;
         }
-
-        gameLog->append("\nOptimal solution:");
-        gameLog->append(optimalPathQt.join(" → "));
     }
 
     endGame();
@@ -371,6 +563,55 @@ void MainWindow::onLoadAnalyticsClicked() {
         return;
     }
 
+    // Sessions may come from any length, so they are solved in one batch per word length.
+    std::map<int, std::vector<int>> sessionsByLength;
+    std::map<int, std::vector<Solver::BatchQuery>> queriesByLength;
+    for (int i = 0; i < sessions.size(); ++i) {
+        const int length = sessions[i].getStartWord().length();
+        sessionsByLength[length].push_back(i);
+        queriesByLength[length].push_back({ sessions[i].getStartWord().toStdString(),
+            sessions[i].getTargetWord().toStdString() });
+    }
+
+    const unsigned generation = ++analyticsGeneration;
+    loadAnalyticsButton->setEnabled(false);
+    analyticsOutput->setText(QString("Solving %1 games...").arg(sessions.size()));
+
+    loadPool.start([this, generation, username, sessions, sessionsByLength, queriesByLength]() {
+        std::vector<int> optimalMovesOf(sessions.size(), 0);
+        QString error;
+        try {
+            Solver::BatchOptions batchOptions;
+            batchOptions.withPaths = false;
+            for (const auto& group : sessionsByLength) {
+                if (analyticsGeneration != generation) return;
+                std::vector<Solver::BatchResult> results
+                    = graphCache->get(group.first)->solveBatch(queriesByLength.at(group.first), batchOptions);
+                for (std::size_t k = 0; k < results.size(); ++k) {
+                    optimalMovesOf[group.second[k]] = std::max(0, results[k].distance);
+                }
+            }
+        }
+        catch (const std::exception& e) {
+            error = e.what();
+        }
+        if (analyticsGeneration != generation) return;
+
+        QMetaObject::invokeMethod(this, [this, generation, username, sessions, optimalMovesOf, error]() {
+            if (analyticsGeneration != generation) return;
+            loadAnalyticsButton->setEnabled(true);
+            if (!error.isEmpty()) {
+                analyticsOutput->clear();
+                QMessageBox::critical(this, "Error", "Failed to load dictionary: " + error);
+                return;
+            }
+            showAnalytics(username, sessions, optimalMovesOf);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::showAnalytics(const QString& username, const QList<GameSession>& sessions,
+    const std::vector<int>& optimalMovesOf) {
     QString report;
     report += QString("Game sessions for %1:\n\n").arg(username);
 
@@ -380,15 +621,13 @@ void MainWindow::onLoadAnalyticsClicked() {
     int totalMoves = 0;
     int totalOptimalMoves = 0;
 
-    for (const auto& session : sessions) {
+    for (int i = 0; i < sessions.size(); ++i) {
+        const GameSession& session = sessions[i];
         totalGames++;
         totalHints += session.getHintsUsed();
         totalMoves += session.getMoveCount();
 
-        auto optimalPath = solver->findShortestPath(
-            session.getStartWord().toStdString(),
-            session.getTargetWord().toStdString());
-        int optimalMoves = optimalPath.empty() ? 0 : optimalPath.size() - 1;
+        int optimalMoves = optimalMovesOf[i];
         totalOptimalMoves += optimalMoves;
 
         for (const auto& word : session.getMoves()) {
@@ -421,10 +660,13 @@ void MainWindow::updateGameDisplay() {
         .arg(currentGame->getCurrentWord()));
     targetWordLabel->setText(QString("Target word: <b>%1</b>")
         .arg(currentGame->getTargetWord()));
-    statsLabel->setText(QString("Moves: %1/%2 | Hints used: %3")
+    int remaining = playSolver->distanceToTarget(currentGame->getCurrentWord().toStdString(),
+        currentGame->getTargetWord().toStdString());
+    statsLabel->setText(QString("Moves: %1/%2 | Hints used: %3 | Moves to target: %4")
         .arg(currentGame->getMoveCount())
         .arg(currentGame->getOptimalMoves())
-        .arg(currentGame->getHintsUsed()));
+        .arg(currentGame->getHintsUsed())
+        .arg(remaining >= 0 ? QString::number(remaining) : QString("?")));
 }
 
 void MainWindow::endGame() {
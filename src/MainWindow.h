@@ -8,9 +8,16 @@
 #include <QLineEdit>
 #include <QLabel>
 #include <QTextEdit>
+#include <QProgressBar>
+#include <QThreadPool>
 #include "GameSession.h"
 #include "Solver.h"
-#include "GraphBuilder.h"
+#include "GraphCache.h"
+#include "PuzzlePool.h"
+#include <atomic>
+#include <memory>
+
+class WordListModel;
 
 /**
  * @class MainWindow
@@ -55,6 +62,18 @@ private slots:
      */
     void onWordLengthChanged(int index);
 
+    /**
+     * @brief Handles changes in the play tab's word length combo box.
+     * @param index Index of the selected word length.
+     */
+    void onPlayWordLengthChanged(int index);
+
+    /**
+     * @brief Handles changes in the play tab's difficulty combo box.
+     * @param index Index of the selected difficulty.
+     */
+    void onPlayDifficultyChanged(int index);
+
     /**
      * @brief Handles the Make Move button click in play mode.
      */
@@ -72,6 +91,9 @@ private slots:
 
     /**
      * @brief Handles the Load Analytics button click in analytics mode.
+     *
+     * The optimal move counts are solved on a background worker, since fetching a
+     * solver may build its graph; the report is shown on the GUI thread once they are in.
      */
     void onLoadAnalyticsClicked();
 
@@ -92,10 +114,47 @@ private:
     void setupAnalyticsTab();
 
     /**
-     * @brief Loads the dictionary file into memory and builds the word graph.
+     * @brief Loads the solver and word lists for the automatic tab's word length.
+     *
+     * The solver and the shared dictionary index are fetched on a background worker; the
+     * results are applied on the GUI thread, and Solve stays disabled until then.
+     * Starting another load cancels one still in progress. If the load fails, the user
+     * can retry at once, and Solve is enabled again to retry later.
      */
     void loadDictionary();
 
+    /**
+     * @brief Loads the solver for the play tab's word length, keeping Start Game disabled until ready.
+     *
+     * As with loadDictionary(), a failed load offers a retry and re-enables Start Game to retry later.
+     */
+    void loadPlaySolver();
+
+    /**
+     * @brief Applies a dictionary reload reported by the graph cache's watcher.
+     *
+     * Both tabs load their solvers again from the new snapshot; a game in progress keeps
+     * the solver, and so the words, it started with.
+     *
+     * @param next The published snapshot, or nullptr if the reload failed.
+     */
+    void onDictionaryReloaded(std::shared_ptr<const GraphSnapshot> next);
+
+    /**
+     * @brief Returns the puzzle constraints of the play tab's selected difficulty.
+     */
+    PuzzleGenerator::Options playPuzzleOptions() const;
+
+    /**
+     * @brief Writes the analytics report of a player's sessions.
+     *
+     * @param username The player's name.
+     * @param sessions The player's game sessions.
+     * @param optimalMovesOf Optimal number of moves of each session, in the same order.
+     */
+    void showAnalytics(const QString& username, const QList<GameSession>& sessions,
+        const std::vector<int>& optimalMovesOf);
+
     /**
      * @brief Updates the UI elements that display the game state.
      */
@@ -121,15 +180,18 @@ private:
     QComboBox* wordLengthComboAuto;   ///< Combo box for word length selection
     QComboBox* startWordComboAuto;    ///< Combo box for start word selection
     QComboBox* targetWordComboAuto;   ///< Combo box for target word selection
+    WordListModel* wordListModel;     ///< Words of the selected length, shared by both word combo boxes
     QPushButton* solveButton;         ///< Button to trigger solving
     QListWidget* solutionList;        ///< List widget to show solution steps
 
     // Play Tab
     QLineEdit* playerNameEdit;        ///< Input for player name
     QComboBox* wordLengthComboPlay;   ///< Combo box for word length in play mode
+    QComboBox* difficultyComboPlay;   ///< Combo box for the optimal ladder length in play mode
     QLabel* currentWordLabel;         ///< Label showing the current word
     QLabel* targetWordLabel;          ///< Label showing the target word
     QLineEdit* wordInput;             ///< Input field for player's next word
+    QPushButton* startGameButton;     ///< Button to start a new game
     QPushButton* makeMoveButton;      ///< Button to submit a move
     QPushButton* hintButton;          ///< Button to request a hint
     QPushButton* giveUpButton;        ///< Button to give up the game
@@ -142,10 +204,21 @@ private:
     QPushButton* loadAnalyticsButton; ///< Button to load analytics
     QTextEdit* analyticsOutput;       ///< Text area showing analytics results
 
+    QProgressBar* loadProgress;       ///< Status bar progress of dictionary loading
+    QLabel* reloadStatus;             ///< Status bar report of the last dictionary reload
+
     // Game Data
     GameSession* currentGame;         ///< Current game session object
-    Solver* solver;                   ///< Solver object for automatic mode
-    Graph<std::string> wordGraph;     ///< Graph used for solving word ladders
-    std::vector<std::string> dictionary; ///< Loaded dictionary of valid words
+    std::shared_ptr<const Solver> solver;     ///< Solver for the automatic tab's word length
+    std::shared_ptr<const Solver> playSolver; ///< Solver for the current game's word length
+    std::shared_ptr<const Solver> nextGameSolver; ///< Solver for the play tab's selected word length
+    std::unique_ptr<PuzzlePool> puzzlePool;   ///< Puzzles for the next games, generated in the background
     QString currentDictionaryFile = "dictionary.txt"; ///< Path to dictionary file
+    QString currentGraphImageFile = "dictionary.wlg"; ///< Path to the precompiled graph image
+    std::size_t graphMemoryBudget = GraphCache::DefaultMemoryBudget; ///< Memory budget of the graph cache
+    std::unique_ptr<GraphCache> graphCache;   ///< Solvers for every word length
+    QThreadPool loadPool;                     ///< Workers fetching solvers off the GUI thread
+    std::atomic<unsigned> autoLoadGeneration{ 0 }; ///< Latest automatic-tab load; older ones cancel
+    std::atomic<unsigned> playLoadGeneration{ 0 }; ///< Latest play-tab load; older ones cancel
+    std::atomic<unsigned> analyticsGeneration{ 0 }; ///< Latest analytics request; older ones cancel
 };
@@ -0,0 +1,181 @@
+#include "MappedDictionary.h"
+#include "BitOps.h"
+#include "MappedFile.h"
+#include "PackedWord.h"
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+#include <emmintrin.h>
+#define WORD_LADDER_SSE2 1
+#endif
+
+namespace {
+
+/**
+ * @brief Checks whether a byte separates words (space or any control character).
+ */
+inline bool isSeparator(char c) {
+    return static_cast<unsigned char>(c) <= ' ';
+}
+
+/**
+ * @brief Returns the first position in [pos, end) whose separator state equals wanted.
+ */
+std::size_t scanUntil(const char* data, std::size_t pos, std::size_t end, bool wanted) {
+#if defined(WORD_LADDER_SSE2)
+    const __m128i space = _mm_set1_epi8(' ');
+    while (pos + 16 <= end) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + pos));
+        // Unsigned c <= ' ' holds exactly when min(c, ' ') == c.
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_cmpeq_epi8(_mm_min_epu8(chunk, space), chunk)));
+        if (!wanted) mask = ~mask & 0xFFFFu;
+        if (mask != 0) return pos + lowestBitIndex(mask);
+        pos += 16;
+    }
+#endif
+    while (pos < end && isSeparator(data[pos]) != wanted) ++pos;
+    return pos;
+}
+
+/**
+ * @brief Open-addressing set of words, storing indices into the accepted word list.
+ *
+ * Each slot keeps the word's key next to its index, so probes rarely touch the arena.
+ * Words of up to 12 letters are keyed by their exact PackedWord code; longer words are
+ * keyed by an FNV-1a hash and confirmed by comparing the text.
+ */
+class WordSet {
+public:
+    WordSet(const std::vector<std::string_view>& words, std::size_t expectedWords) : words(words) {
+        std::size_t capacity = 1024;
+        while (capacity < expectedWords * 2) capacity <<= 1;
+        slots.resize(capacity);
+    }
+
+    /**
+     * @brief Checks whether a word is present; if not, records that it is words[index].
+     * @return True if the word was inserted, false if it was already present.
+     */
+    bool insert(std::string_view word, std::size_t index) {
+        if ((used + 1) * 2 > slots.size()) grow();
+
+        std::uint64_t key;
+        const bool exact = PackedWord::pack(word.data(), word.size(), key);
+        if (!exact) key = hash(word) | (std::uint64_t(1) << 63);
+
+        const std::size_t mask = slots.size() - 1;
+        std::size_t slot = static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+        for (; slots[slot].index != 0; slot = (slot + 1) & mask) {
+            if (slots[slot].key == key && (exact || words[slots[slot].index - 1] == word)) return false;
+        }
+        slots[slot] = { key, static_cast<std::uint32_t>(index + 1) };
+        ++used;
+        return true;
+    }
+
+private:
+    struct Slot {
+        std::uint64_t key = 0;     ///< Packed code or tagged hash of the word.
+        std::uint32_t index = 0;   ///< One plus the word's index, or 0 if empty.
+    };
+
+    static std::uint64_t hash(std::string_view word) {
+        std::uint64_t h = 0xcbf29ce484222325ull;
+        for (char c : word) h = (h ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+        return h >> 1;
+    }
+
+    void grow() {
+        std::vector<Slot> old(slots.size() * 2);
+        old.swap(slots);
+        const std::size_t mask = slots.size() - 1;
+        for (const Slot& entry : old) {
+            if (entry.index == 0) continue;
+            std::size_t slot = static_cast<std::size_t>((entry.key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+            while (slots[slot].index != 0) slot = (slot + 1) & mask;
+            slots[slot] = entry;
+        }
+    }
+
+    const std::vector<std::string_view>& words;
+    std::vector<Slot> slots;
+    std::size_t used = 0;
+};
+
+}
+
+ MappedDictionary::MappedDictionary(const std::string& filename) {
+    MappedFile mapping(filename);
+    foldIntoArena(mapping.getData(), mapping.getSize());
+    tokenize();
+}
+
+ std::vector<std::string_view> MappedDictionary::getWords(std::size_t length) const {
+    if (length == 0) return words;
+
+    std::vector<std::string_view> selected;
+    for (std::string_view word : words) {
+        if (word.length() == length) selected.push_back(word);
+    }
+    return selected;
+}
+
+ void MappedDictionary::foldIntoArena(const char* data, std::size_t size) {
+    arena.reset(new char[size + 1]);
+    arenaSize = size;
+    char* out = arena.get();
+    std::size_t i = 0;
+
+#if defined(WORD_LADDER_SSE2)
+    // Bytes in 'a'..'z' are shifted down by 32; signed compares are safe for ASCII letters.
+    const __m128i beforeA = _mm_set1_epi8('a' - 1);
+    const __m128i afterZ = _mm_set1_epi8('z' + 1);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+    for (; i + 16 <= size; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        __m128i lower = _mm_and_si128(_mm_cmpgt_epi8(chunk, beforeA), _mm_cmplt_epi8(chunk, afterZ));
+        chunk = _mm_sub_epi8(chunk, _mm_and_si128(lower, caseBit));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), chunk);
+    }
+#endif
+
+    for (; i < size; ++i) {
+        char c = data[i];
+        out[i] = (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    out[size] = '\0';
+}
+
+ void MappedDictionary::tokenize() {
+    const char* data = arena.get();
+    // Typical word lists average about eight bytes per line; both containers grow if needed.
+    words.reserve(arenaSize / 8);
+    WordSet seen(words, arenaSize / 8);
+
+    std::size_t pos = scanUntil(data, 0, arenaSize, false);
+    while (pos < arenaSize) {
+        std::size_t end = scanUntil(data, pos, arenaSize, true);
+        std::string_view token(data + pos, end - pos);
+
+        bool valid = true;
+        for (char c : token) {
+            if (c < 'A' || c > 'Z') {
+                valid = false;
+                break;
+            }
+        }
+
+        if (!valid) {
+            rejectedCount++;
+        }
+        else if (!seen.insert(token, words.size())) {
+            duplicateCount++;
+        }
+        else {
+            words.push_back(token);
+        }
+
+        pos = scanUntil(data, end, arenaSize, false);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @class MappedDictionary
+ * @brief Loads a word list by memory-mapping the file and tokenizing it in one arena.
+ * @ingroup Graph Graph Structures
+ *
+ * The file is mapped read-only once and copied into a single arena while being folded
+ * to upper case sixteen bytes at a time (SSE2 where available). The arena is then split
+ * on whitespace in place, again scanning sixteen bytes per step, and every token is
+ * checked against the 'A'-'Z' alphabet. Valid, first-seen words are handed out as
+ * string views into the arena, in file order, so no per-word allocation takes place.
+ *
+ * The views stay valid for the lifetime of the object, including after it is moved.
+ */
+
+class MappedDictionary {
+public:
+    /**
+     * @brief Maps and tokenizes a dictionary file.
+     *
+     * @param filename Path to the dictionary file.
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedDictionary(const std::string& filename);
+
+    MappedDictionary(MappedDictionary&&) = default;
+    MappedDictionary& operator=(MappedDictionary&&) = default;
+    MappedDictionary(const MappedDictionary&) = delete;
+    MappedDictionary& operator=(const MappedDictionary&) = delete;
+
+    /**
+     * @brief Returns all accepted words in file order.
+     */
+    const std::vector<std::string_view>& getWords() const { return words; }
+
+    /**
+     * @brief Returns the accepted words of one length, in file order.
+     *
+     * @param length Word length to select. If 0, all words are returned.
+     */
+    std::vector<std::string_view> getWords(std::size_t length) const;
+
+    /**
+     * @brief Returns the number of tokens dropped for containing characters other than letters.
+     */
+    std::size_t getRejectedCount() const { return rejectedCount; }
+
+    /**
+     * @brief Returns the number of tokens dropped because they were already seen.
+     */
+    std::size_t getDuplicateCount() const { return duplicateCount; }
+
+    /**
+     * @brief Returns the size of the arena holding the folded file contents.
+     */
+    std::size_t getArenaSize() const { return arenaSize; }
+
+private:
+    /**
+     * @brief Copies the mapped bytes into the arena, folding 'a'-'z' to 'A'-'Z'.
+     */
+    void foldIntoArena(const char* data, std::size_t size);
+
+    /**
+     * @brief Splits the arena into words and filters invalid and repeated tokens.
+     */
+    void tokenize();
+
+    std::unique_ptr<char[]> arena;         ///< Upper-cased copy of the file.
+    std::size_t arenaSize = 0;             ///< Number of bytes in the arena.
+    std::vector<std::string_view> words;   ///< Accepted words, viewing the arena.
+    std::size_t rejectedCount = 0;         ///< Tokens outside the alphabet.
+    std::size_t duplicateCount = 0;        ///< Repeated tokens.
+};
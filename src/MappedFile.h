@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile
+ * @brief A read-only memory mapping of a whole file, released on destruction.
+ * @ingroup Graph Graph Structures
+ *
+ * Uses mmap on POSIX systems and a file mapping object on Windows. The file handle is
+ * closed right after mapping; only the view is kept. Empty files are not mapped and
+ * report a null data pointer with size 0.
+ */
+
+class MappedFile {
+public:
+    /**
+     * @brief Maps a file into memory.
+     *
+     * @param filename Path to the file.
+     * @throws std::runtime_error If the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& filename);
+
+    /**
+     * @brief Unmaps the file.
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Returns the first byte of the mapping, or nullptr for an empty file.
+     */
+    const char* getData() const { return data; }
+
+    /**
+     * @brief Returns the size of the mapped file in bytes.
+     */
+    std::size_t getSize() const { return size; }
+
+private:
+    const char* data = nullptr; ///< Start of the read-only view.
+    std::size_t size = 0;       ///< Number of mapped bytes.
+};
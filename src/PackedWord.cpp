@@ -0,0 +1,57 @@
+#include "PackedWord.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+ bool PackedWord::differsByOneLetter(const std::string& a, const std::string& b) {
+    if (a.length() != b.length()) return false;
+
+    std::uint64_t codeA, codeB;
+    if (pack(a, codeA) && pack(b, codeB)) {
+        return differsByOneLetter(codeA, codeB);
+    }
+
+    int diffCount = 0;
+    for (std::size_t i = 0; i < a.length() && diffCount < 2; ++i) {
+        if (a[i] != b[i]) diffCount++;
+    }
+    return diffCount == 1;
+}
+
+ void PackedWord::findOneLetterMatches(std::uint64_t query, const std::uint64_t* candidates,
+    std::size_t count, std::vector<std::uint32_t>& matches) {
+    std::size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i queryLanes = _mm256_set1_epi64x(static_cast<long long>(query));
+    const __m256i lowBits = _mm256_set1_epi64x(static_cast<long long>(FieldLowBits));
+    const __m256i ones = _mm256_set1_epi64x(1);
+    const __m256i zero = _mm256_setzero_si256();
+
+    for (; i + 4 <= count; i += 4) {
+        __m256i diff = _mm256_xor_si256(queryLanes,
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(candidates + i)));
+        __m256i fields = _mm256_or_si256(
+            _mm256_or_si256(diff, _mm256_srli_epi64(diff, 1)),
+            _mm256_or_si256(_mm256_srli_epi64(diff, 2),
+                _mm256_or_si256(_mm256_srli_epi64(diff, 3), _mm256_srli_epi64(diff, 4))));
+        fields = _mm256_and_si256(fields, lowBits);
+
+        // Exactly one field differs: the mask is non-zero and a power of two.
+        __m256i isZero = _mm256_cmpeq_epi64(fields, zero);
+        __m256i singleBit = _mm256_cmpeq_epi64(
+            _mm256_and_si256(fields, _mm256_sub_epi64(fields, ones)), zero);
+        int laneMask = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_andnot_si256(isZero, singleBit)));
+
+        for (int lane = 0; laneMask != 0; ++lane, laneMask >>= 1) {
+            if (laneMask & 1) matches.push_back(static_cast<std::uint32_t>(i + lane));
+        }
+    }
+#endif
+
+    for (; i < count; ++i) {
+        if (differsByOneLetter(query, candidates[i])) {
+            matches.push_back(static_cast<std::uint32_t>(i));
+        }
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class PackedWord
+ * @brief Encodes short upper-case words as 64-bit integers, five bits per letter.
+ * @ingroup Graph Graph Structures
+ *
+ * Letter @c i of the word occupies bits [5i, 5i + 5) and holds a code from 1 ('A')
+ * to 26 ('Z'). Unused fields are zero, so words of different lengths never share an
+ * encoding. Words longer than MaxLength or containing anything other than 'A'-'Z'
+ * cannot be packed.
+ *
+ * Two packed words differ in exactly one letter when their XOR has exactly one non-zero
+ * field. differsByOneLetter() checks this with a few shifts and a single-bit test, and
+ * findOneLetterMatches() applies the same test to four candidates at a time with AVX2
+ * when the compiler targets it, falling back to the scalar test otherwise.
+ */
+
+class PackedWord {
+public:
+    static constexpr std::size_t MaxLength = 12;      ///< Longest word that fits in 60 bits.
+    static constexpr std::size_t BitsPerLetter = 5;   ///< Width of one letter field.
+    static constexpr std::uint64_t LetterMask = 0x1F; ///< Mask of a single letter field.
+    static constexpr std::uint64_t Wildcard = 0x1F;   ///< Field value marking a wildcard position.
+    static constexpr std::uint64_t FieldLowBits = 0x0084210842108421ull; ///< Lowest bit of every field.
+
+    /**
+     * @brief Packs a word into a 64-bit code.
+     *
+     * @param word Pointer to the letters to encode (upper-case letters only).
+     * @param length Number of letters.
+     * @param code Receives the packed code on success.
+     * @return True if the word could be packed, false otherwise.
+     */
+    static bool pack(const char* word, std::size_t length, std::uint64_t& code) {
+        if (length == 0 || length > MaxLength) return false;
+        std::uint64_t result = 0;
+        for (std::size_t i = 0; i < length; ++i) {
+            const char letter = word[i];
+            if (letter < 'A' || letter > 'Z') return false;
+            result |= static_cast<std::uint64_t>(letter - 'A' + 1) << (BitsPerLetter * i);
+        }
+        code = result;
+        return true;
+    }
+
+    /**
+     * @brief Packs a word into a 64-bit code.
+     *
+     * @param word The word to encode (upper-case letters only).
+     * @param code Receives the packed code on success.
+     * @return True if the word could be packed, false otherwise.
+     */
+    static bool pack(const std::string& word, std::uint64_t& code) {
+        return pack(word.data(), word.size(), code);
+    }
+
+    /**
+     * @brief Decodes a packed word back into a string.
+     *
+     * @param code A code produced by pack().
+     * @return The decoded word.
+     */
+    static std::string unpack(std::uint64_t code) {
+        std::string word;
+        for (; code != 0; code >>= BitsPerLetter) {
+            word.push_back(static_cast<char>('A' + (code & LetterMask) - 1));
+        }
+        return word;
+    }
+
+    /**
+     * @brief Replaces one letter field of a packed word with the wildcard value.
+     *
+     * @param code A packed word.
+     * @param position Index of the letter to replace.
+     * @return The pattern key for the word with that position masked out.
+     */
+    static std::uint64_t withWildcard(std::uint64_t code, std::size_t position) {
+        return code | (Wildcard << (BitsPerLetter * position));
+    }
+
+    /**
+     * @brief Collapses every non-zero field of a word to the lowest bit of that field.
+     *
+     * @param diff The XOR of two packed words.
+     * @return A mask with one bit set per differing letter.
+     */
+    static std::uint64_t differingFields(std::uint64_t diff) {
+        return (diff | diff >> 1 | diff >> 2 | diff >> 3 | diff >> 4) & FieldLowBits;
+    }
+
+    /**
+     * @brief Checks whether two packed words of the same length differ in exactly one letter.
+     *
+     * @param a First packed word.
+     * @param b Second packed word.
+     * @return True if exactly one letter position differs.
+     */
+    static bool differsByOneLetter(std::uint64_t a, std::uint64_t b) {
+        std::uint64_t mask = differingFields(a ^ b);
+        return mask != 0 && (mask & (mask - 1)) == 0;
+    }
+
+    /**
+     * @brief Checks whether two words differ in exactly one letter.
+     *
+     * Uses the packed kernel when both words can be packed and a character loop otherwise.
+     *
+     * @param a First word.
+     * @param b Second word.
+     * @return True if both words have the same length and exactly one letter differs.
+     */
+    static bool differsByOneLetter(const std::string& a, const std::string& b);
+
+    /**
+     * @brief Finds all candidates that differ from a query word in exactly one letter.
+     *
+     * @param query The packed query word.
+     * @param candidates Packed words of the same length as the query.
+     * @param count Number of candidates.
+     * @param matches Receives the indices of matching candidates, in increasing order.
+     */
+    static void findOneLetterMatches(std::uint64_t query, const std::uint64_t* candidates,
+        std::size_t count, std::vector<std::uint32_t>& matches);
+};
@@ -0,0 +1,120 @@
+#include "PatternIndex.h"
+#include "PackedWord.h"
+
+namespace {
+
+/**
+ * @brief Spreads a pattern key over the table with Fibonacci hashing.
+ */
+inline std::size_t slotFor(std::uint64_t key, std::size_t mask) {
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ull) >> 32) & mask;
+}
+
+}
+
+ void PatternIndex::build(const std::vector<std::string_view>& words) {
+    clear();
+
+    std::size_t patternCount = 0;
+    for (const auto& word : words) patternCount += word.length();
+
+    // Keep the load factor at or below one half.
+    std::size_t capacity = 16;
+    while (capacity < patternCount * 2) capacity <<= 1;
+    slotKeys.assign(capacity, EmptyKey);
+    slotSize.assign(capacity, 0);
+
+    std::vector<std::uint64_t> codes(words.size(), 0);
+    const std::vector<unsigned char> stringKeyed = stringKeyedWords(words);
+
+    // First pass: claim a slot for every pattern and count its words.
+    for (std::size_t id = 0; id < words.size(); ++id) {
+        std::string_view word = words[id];
+        if (!stringKeyed[id]) {
+            PackedWord::pack(word.data(), word.size(), codes[id]);
+            for (std::size_t i = 0; i < word.length(); ++i) {
+                slotSize[findOrInsert(PackedWord::withWildcard(codes[id], i))]++;
+            }
+        }
+        else {
+            std::string pattern(word);
+            for (std::size_t i = 0; i < pattern.length(); ++i) {
+                char letter = pattern[i];
+                pattern[i] = '*';
+                overflow[pattern].push_back(static_cast<NodeId>(id));
+                pattern[i] = letter;
+            }
+        }
+    }
+
+    slotStart.assign(capacity, 0);
+    std::uint32_t offset = 0;
+    for (std::size_t slot = 0; slot < capacity; ++slot) {
+        slotStart[slot] = offset;
+        offset += slotSize[slot];
+        slotSize[slot] = 0;
+    }
+
+    // Second pass: scatter IDs into their buckets, which keeps each bucket sorted.
+    bucketIds.resize(offset);
+    for (std::size_t id = 0; id < words.size(); ++id) {
+        if (stringKeyed[id]) continue;
+        for (std::size_t i = 0; i < words[id].length(); ++i) {
+            std::size_t slot = findOrInsert(PackedWord::withWildcard(codes[id], i));
+            bucketIds[slotStart[slot] + slotSize[slot]++] = static_cast<NodeId>(id);
+        }
+    }
+}
+
+ std::vector<unsigned char> PatternIndex::stringKeyedWords(const std::vector<std::string_view>& words) {
+    std::vector<unsigned char> mixedLengths;
+    std::uint64_t code;
+    for (std::string_view word : words) {
+        if (PackedWord::pack(word.data(), word.size(), code)) continue;
+        if (mixedLengths.size() <= word.size()) mixedLengths.resize(word.size() + 1, 0);
+        mixedLengths[word.size()] = 1;
+    }
+
+    std::vector<unsigned char> flags(words.size(), 0);
+    if (mixedLengths.empty()) return flags;
+    for (std::size_t id = 0; id < words.size(); ++id) {
+        flags[id] = words[id].size() < mixedLengths.size() && mixedLengths[words[id].size()];
+    }
+    return flags;
+}
+
+ void PatternIndex::clear() {
+    std::vector<std::uint64_t>().swap(slotKeys);
+    std::vector<std::uint32_t>().swap(slotStart);
+    std::vector<std::uint32_t>().swap(slotSize);
+    std::vector<NodeId>().swap(bucketIds);
+    overflow.clear();
+    usedSlots = 0;
+}
+
+ std::size_t PatternIndex::bucketCount() const {
+    return usedSlots + overflow.size();
+}
+
+ std::size_t PatternIndex::memoryUsage() const {
+    std::size_t bytes = slotKeys.capacity() * sizeof(std::uint64_t)
+        + slotStart.capacity() * sizeof(std::uint32_t)
+        + slotSize.capacity() * sizeof(std::uint32_t)
+        + bucketIds.capacity() * sizeof(NodeId);
+    for (const auto& entry : overflow) {
+        bytes += entry.first.capacity() + entry.second.capacity() * sizeof(NodeId);
+    }
+    return bytes;
+}
+
+ std::size_t PatternIndex::findOrInsert(std::uint64_t key) {
+    const std::size_t mask = slotKeys.size() - 1;
+    for (std::size_t slot = slotFor(key, mask);; slot = (slot + 1) & mask) {
+        if (slotKeys[slot] == key) return slot;
+        if (slotKeys[slot] == EmptyKey) {
+            slotKeys[slot] = key;
+            ++usedSlots;
+            return slot;
+        }
+    }
+}
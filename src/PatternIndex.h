@@ -0,0 +1,105 @@
+#pragma once
+#include "CompactGraph.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class PatternIndex
+ * @brief Groups word IDs by wildcard pattern using packed integer keys.
+ * @ingroup Graph Graph Structures
+ *
+ * Each word is packed with PackedWord and, for every letter position, that field is
+ * replaced by the wildcard value to form a 64-bit pattern key. Keys live in an
+ * open-addressing table with linear probing; the IDs of each bucket are stored
+ * contiguously in one flat array, in increasing ID order.
+ *
+ * Words that cannot be packed (too long or not 'A'-'Z') fall back to string patterns
+ * in a separate map, so the index stays correct for any input. A packed key never meets
+ * a string pattern, so every word of a length that has an unpackable word is keyed by
+ * string pattern as well; that way "BOB" and "B2B" still share the bucket "B*B".
+ */
+
+class PatternIndex {
+public:
+    using NodeId = CompactGraph::NodeId;
+
+    /**
+     * @brief Rebuilds the index from scratch for the given words.
+     *
+     * Any previous contents are discarded. The position of each word in the vector is
+     * used as its ID, so the vector should not contain duplicates.
+     *
+     * @param words List of words to index.
+     */
+    void build(const std::vector<std::string_view>& words);
+
+    /**
+     * @brief Flags the words that have to be keyed by string pattern.
+     *
+     * These are the words that cannot be packed and every other word of the same length.
+     *
+     * @param words List of words, indexed by ID.
+     * @return One flag per word, 1 for string patterns and 0 for packed keys.
+     */
+    static std::vector<unsigned char> stringKeyedWords(const std::vector<std::string_view>& words);
+
+    /**
+     * @brief Removes all patterns and releases the memory held by the index.
+     */
+    void clear();
+
+    /**
+     * @brief Returns the number of distinct patterns in the index.
+     */
+    std::size_t bucketCount() const;
+
+    /**
+     * @brief Calls a function for every bucket with at least two words.
+     *
+     * @param fn Callable invoked as fn(const NodeId* begin, const NodeId* end).
+     */
+    template <typename Fn>
+    void forEachBucket(Fn&& fn) const {
+        for (std::size_t slot = 0; slot < slotKeys.size(); ++slot) {
+            if (slotKeys[slot] != EmptyKey && slotSize[slot] > 1) {
+                const NodeId* first = bucketIds.data() + slotStart[slot];
+                fn(first, first + slotSize[slot]);
+            }
+        }
+        for (const auto& entry : overflow) {
+            if (entry.second.size() > 1) {
+                fn(entry.second.data(), entry.second.data() + entry.second.size());
+            }
+        }
+    }
+
+    /**
+     * @brief Returns the approximate number of bytes held by the index.
+     */
+    std::size_t memoryUsage() const;
+
+private:
+    /**
+     * @brief Key value marking an unused slot. Real keys always contain a wildcard field.
+     */
+    static constexpr std::uint64_t EmptyKey = 0;
+
+    /**
+     * @brief Finds the slot of a key, claiming an empty one if it is not present.
+     */
+    std::size_t findOrInsert(std::uint64_t key);
+
+    std::vector<std::uint64_t> slotKeys;  ///< Pattern key per slot, or EmptyKey.
+    std::vector<std::uint32_t> slotStart; ///< Offset of the slot's bucket in bucketIds.
+    std::vector<std::uint32_t> slotSize;  ///< Number of IDs in the slot's bucket.
+    std::vector<NodeId> bucketIds;        ///< IDs of all buckets, stored back to back.
+    std::size_t usedSlots = 0;            ///< Number of occupied slots.
+
+    /**
+     * @brief Buckets of the words flagged by stringKeyedWords(), keyed by string pattern.
+     */
+    std::unordered_map<std::string, std::vector<NodeId>> overflow;
+};
@@ -0,0 +1,134 @@
+#include "PuzzleGenerator.h"
+#include <algorithm>
+#include <limits>
+#include <random>
+#include <thread>
+#include <utility>
+
+ PuzzleGenerator::PuzzleGenerator(std::shared_ptr<const Solver> solver) : solver(std::move(solver)) {}
+
+ std::vector<PuzzleGenerator::Puzzle> PuzzleGenerator::generate(const Options& options,
+    const std::atomic<bool>* cancel) const {
+    const CompactGraph& graph = solver->getGraph();
+    if (options.count == 0 || options.minDistance > options.maxDistance) return {};
+
+    // A component of s words has no ladder longer than s - 1 moves.
+    std::vector<CompactGraph::NodeId> sources;
+    for (CompactGraph::NodeId id = 0; id < graph.nodeCount(); ++id) {
+        if (graph.componentSize(graph.componentOf(id)) > std::max<std::uint32_t>(options.minDistance, 1)) {
+            sources.push_back(id);
+        }
+    }
+    if (sources.empty()) return {};
+    std::mt19937 shuffle(options.seed);
+    std::shuffle(sources.begin(), sources.end(), shuffle);
+
+    // A few targets per source keep a batch spread over the whole graph.
+    const std::size_t quota = std::max<std::size_t>(1, (4 * options.count + sources.size() - 1) / sources.size());
+
+    unsigned threadCount = options.threadCount;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+    threadCount = std::min<unsigned>(threadCount, static_cast<unsigned>(sources.size()));
+
+    std::vector<std::vector<Puzzle>> found(sources.size());
+    std::atomic<std::size_t> next{ 0 };
+    std::atomic<std::size_t> total{ 0 };
+    auto work = [&]() {
+        Scratch scratch;
+        scratch.depth.assign(graph.nodeCount(), CompactGraph::InvalidId);
+        scratch.paths.assign(graph.nodeCount(), 0);
+        while (total < options.count && !(cancel && *cancel)) {
+            const std::size_t position = next.fetch_add(1);
+            if (position >= sources.size()) break;
+            found[position] = fromSource(sources[position], position, quota, options, scratch);
+            total += found[position].size();
+        }
+    };
+
+    if (threadCount == 1) {
+        work();
+    }
+    else {
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threadCount; ++t) workers.emplace_back(work);
+        for (std::thread& worker : workers) worker.join();
+    }
+
+    // Sources are claimed in order, so the claimed ones form a prefix of the shuffled
+    // order and taking results in that order does not depend on the thread count.
+    std::vector<Puzzle> puzzles;
+    for (std::vector<Puzzle>& batch : found) {
+        for (Puzzle& puzzle : batch) {
+            if (puzzles.size() == options.count) return puzzles;
+            puzzles.push_back(std::move(puzzle));
+        }
+    }
+    return puzzles;
+}
+
+ std::vector<PuzzleGenerator::Puzzle> PuzzleGenerator::generate(std::size_t count, std::uint32_t distance,
+    std::uint32_t seed) const {
+    Options options;
+    options.count = count;
+    options.minDistance = distance;
+    options.maxDistance = distance;
+    options.seed = seed;
+    return generate(options);
+}
+
+ std::vector<PuzzleGenerator::Puzzle> PuzzleGenerator::fromSource(CompactGraph::NodeId source,
+    std::size_t position, std::size_t quota, const Options& options, Scratch& scratch) const {
+    const CompactGraph& graph = solver->getGraph();
+    const std::uint64_t saturated = std::numeric_limits<std::uint64_t>::max();
+
+    scratch.order.clear();
+    scratch.order.push_back(source);
+    scratch.depth[source] = 0;
+    scratch.paths[source] = 1;
+    for (std::size_t head = 0; head < scratch.order.size(); ++head) {
+        const CompactGraph::NodeId current = scratch.order[head];
+        const std::uint32_t d = scratch.depth[current];
+        if (d == options.maxDistance) break;
+        for (const CompactGraph::NodeId* it = graph.neighborsBegin(current); it != graph.neighborsEnd(current); ++it) {
+            if (scratch.depth[*it] == CompactGraph::InvalidId) {
+                scratch.depth[*it] = d + 1;
+                scratch.order.push_back(*it);
+            }
+            if (scratch.depth[*it] == d + 1) {
+                const std::uint64_t add = scratch.paths[current];
+                scratch.paths[*it] = scratch.paths[*it] > saturated - add ? saturated : scratch.paths[*it] + add;
+            }
+        }
+    }
+
+    // Reservoir sampling keeps a uniform choice of qualifying targets in one pass.
+    std::seed_seq seeds{ options.seed, static_cast<std::uint32_t>(position), static_cast<std::uint32_t>(std::uint64_t(position) >> 32) };
+    std::mt19937 generator(seeds);
+    std::vector<CompactGraph::NodeId> chosen;
+    std::size_t seen = 0;
+    for (CompactGraph::NodeId id : scratch.order) {
+        const std::uint32_t d = scratch.depth[id];
+        if (d < options.minDistance || d == 0) continue;
+        if (options.maxSolutions != 0 && scratch.paths[id] > options.maxSolutions) continue;
+        ++seen;
+        if (chosen.size() < quota) {
+            chosen.push_back(id);
+        }
+        else {
+            std::uniform_int_distribution<std::size_t> pick(0, seen - 1);
+            const std::size_t slot = pick(generator);
+            if (slot < quota) chosen[slot] = id;
+        }
+    }
+
+    std::vector<Puzzle> puzzles;
+    for (CompactGraph::NodeId target : chosen) {
+        puzzles.push_back({ graph.wordOf(source), graph.wordOf(target), scratch.depth[target], scratch.paths[target] });
+    }
+
+    for (CompactGraph::NodeId visited : scratch.order) {
+        scratch.depth[visited] = CompactGraph::InvalidId;
+        scratch.paths[visited] = 0;
+    }
+    return puzzles;
+}
@@ -0,0 +1,101 @@
+#pragma once
+#include "Solver.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @class PuzzleGenerator
+ * @brief Produces batches of distinct puzzles whose optimal ladder length lies in a given range.
+ * @ingroup Core Core Logic
+ *
+ * Instead of drawing random pairs and rejecting unsuitable ones, the generator runs a
+ * BFS from each sampled source word and takes its targets directly from the BFS layers
+ * at the requested distances. The BFS stops after the deepest requested layer.
+ *
+ * The same BFS counts the shortest paths into each word (the sum over its parents in the
+ * previous layer), so pairs with too many optimal solutions can be excluded. Counts
+ * saturate at UINT64_MAX instead of overflowing.
+ *
+ * Sources are taken from a shuffled order of all words, one per task, by several worker
+ * threads. Each source uses its own random stream derived from the seed and its
+ * position, so a given seed yields the same puzzles for any number of threads.
+ */
+
+class PuzzleGenerator {
+public:
+    /**
+     * @brief A start and target word together with the properties of their shortest ladders.
+     */
+    struct Puzzle {
+        std::string start;               ///< The starting word.
+        std::string target;              ///< The target word.
+        std::uint32_t distance = 0;      ///< Number of moves of an optimal ladder.
+        std::uint64_t solutionCount = 0; ///< Number of distinct optimal ladders, saturated.
+    };
+
+    /**
+     * @brief What to generate.
+     */
+    struct Options {
+        std::size_t count = 1;          ///< Number of puzzles wanted.
+        std::uint32_t minDistance = 1;  ///< Shortest accepted optimal ladder, in moves.
+        std::uint32_t maxDistance = CompactGraph::InvalidId; ///< Longest accepted optimal ladder, in moves.
+        std::uint64_t maxSolutions = 0; ///< Largest accepted number of optimal ladders; 0 means no limit.
+        unsigned threadCount = 0;       ///< Worker threads; 0 uses hardware concurrency.
+        std::uint32_t seed = 0;         ///< Seed of the random choices.
+    };
+
+    /**
+     * @brief Creates a generator for the words of one solver.
+     *
+     * @param solver The solver whose graph puzzles are drawn from.
+     */
+    explicit PuzzleGenerator(std::shared_ptr<const Solver> solver);
+
+    /**
+     * @brief Generates distinct puzzles matching the options.
+     *
+     * Each source contributes only a few targets, so a batch is spread over the graph.
+     * Fewer puzzles than requested are returned when every word has been tried as a
+     * source, or when generation is cancelled.
+     *
+     * @param options Number of puzzles and their constraints.
+     * @param cancel Optional flag that stops generation early when set.
+     * @return The puzzles, in a deterministic order for a given seed.
+     */
+    std::vector<Puzzle> generate(const Options& options, const std::atomic<bool>* cancel = nullptr) const;
+
+    /**
+     * @brief Generates puzzles with exactly the given optimal ladder length.
+     *
+     * @param count Number of puzzles wanted.
+     * @param distance Optimal ladder length, in moves.
+     * @param seed Seed of the random choices.
+     */
+    std::vector<Puzzle> generate(std::size_t count, std::uint32_t distance, std::uint32_t seed = 0) const;
+
+private:
+    /**
+     * @brief Per-thread BFS buffers, reset after every source.
+     */
+    struct Scratch {
+        std::vector<std::uint32_t> depth;  ///< BFS depth, InvalidId where not reached.
+        std::vector<std::uint64_t> paths;  ///< Saturated number of shortest paths from the source.
+        std::vector<CompactGraph::NodeId> order; ///< Visited words in BFS order.
+    };
+
+    /**
+     * @brief Collects the puzzles contributed by one source word.
+     *
+     * @param source ID of the source word.
+     * @param position Position of the source in the shuffled order, used for its random stream.
+     * @param quota Maximum number of puzzles taken from this source.
+     */
+    std::vector<Puzzle> fromSource(CompactGraph::NodeId source, std::size_t position, std::size_t quota,
+        const Options& options, Scratch& scratch) const;
+
+    std::shared_ptr<const Solver> solver; ///< Keeps the graph alive.
+};
@@ -0,0 +1,64 @@
+#include "PuzzlePool.h"
+#include <algorithm>
+#include <random>
+#include <utility>
+
+ PuzzlePool::PuzzlePool(std::shared_ptr<const Solver> solver, const PuzzleGenerator::Options& options,
+    std::size_t capacity)
+    : generator(std::move(solver)), options(options), capacity(std::max<std::size_t>(1, capacity)) {
+    worker = std::thread(&PuzzlePool::refill, this);
+}
+
+ PuzzlePool::~PuzzlePool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    wanted.notify_all();
+    worker.join();
+}
+
+ bool PuzzlePool::tryTake(PuzzleGenerator::Puzzle& puzzle) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (stock.empty()) return false;
+    puzzle = std::move(stock.front());
+    stock.pop_front();
+    if (stock.size() <= capacity / 2) wanted.notify_all();
+    return true;
+}
+
+ std::size_t PuzzlePool::size() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return stock.size();
+}
+
+ bool PuzzlePool::exhausted() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return noMatches;
+}
+
+ void PuzzlePool::refill() {
+    std::random_device seeds;
+    while (true) {
+        std::size_t missing;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            wanted.wait(lock, [this]() { return stopping || stock.size() <= capacity / 2; });
+            if (stopping) return;
+            missing = capacity - stock.size();
+        }
+
+        PuzzleGenerator::Options batch = options;
+        batch.count = missing;
+        batch.seed = seeds();
+        std::vector<PuzzleGenerator::Puzzle> puzzles = generator.generate(batch, &stopping);
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (stopping) return;
+        if (puzzles.empty()) {
+            noMatches = true;
+            return;
+        }
+        for (PuzzleGenerator::Puzzle& puzzle : puzzles) stock.push_back(std::move(puzzle));
+    }
+}
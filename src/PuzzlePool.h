@@ -0,0 +1,82 @@
+#pragma once
+#include "PuzzleGenerator.h"
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class PuzzlePool
+ * @brief Keeps a stock of ready puzzles, refilled by a background thread.
+ * @ingroup Core Core Logic
+ *
+ * The pool starts generating as soon as it is constructed, and whenever fewer than half of
+ * its capacity remain, it generates another batch with a fresh seed. tryTake() only
+ * pops from the stock, so it never waits for a search.
+ *
+ * If a batch comes back empty, no words match the options and the pool stops
+ * refilling; exhausted() then returns true.
+ *
+ * All methods are thread-safe.
+ */
+
+class PuzzlePool {
+public:
+    static constexpr std::size_t DefaultCapacity = 32; ///< Puzzles kept in stock.
+
+    /**
+     * @brief Creates the pool and starts filling it in the background.
+     *
+     * @param solver The solver whose graph puzzles are drawn from.
+     * @param options Constraints of the puzzles; the count and seed are chosen by the pool.
+     * @param capacity Number of puzzles to keep in stock.
+     */
+    PuzzlePool(std::shared_ptr<const Solver> solver, const PuzzleGenerator::Options& options,
+        std::size_t capacity = DefaultCapacity);
+
+    /**
+     * @brief Cancels the batch in progress and waits for the background thread.
+     */
+    ~PuzzlePool();
+
+    PuzzlePool(const PuzzlePool&) = delete;
+    PuzzlePool& operator=(const PuzzlePool&) = delete;
+
+    /**
+     * @brief Takes a puzzle from the stock without blocking.
+     *
+     * @param puzzle Receives the puzzle.
+     * @return False if the stock is currently empty.
+     */
+    bool tryTake(PuzzleGenerator::Puzzle& puzzle);
+
+    /**
+     * @brief Returns the number of puzzles in stock.
+     */
+    std::size_t size() const;
+
+    /**
+     * @brief Returns true if the pool found no puzzles matching its options.
+     */
+    bool exhausted() const;
+
+private:
+    /**
+     * @brief Body of the background thread.
+     */
+    void refill();
+
+    PuzzleGenerator generator;           ///< Generates the batches.
+    PuzzleGenerator::Options options;    ///< Constraints of every batch.
+    std::size_t capacity;                ///< Target stock size.
+
+    mutable std::mutex mutex;                  ///< Guards the members below.
+    std::condition_variable wanted;            ///< Signalled when the stock runs low or on shutdown.
+    std::deque<PuzzleGenerator::Puzzle> stock; ///< Puzzles ready to be taken.
+    bool noMatches = false;                    ///< Whether a batch came back empty.
+
+    std::atomic<bool> stopping{ false }; ///< Cancels generation on destruction.
+    std::thread worker;                  ///< Background generator thread, started last.
+};
@@ -1,31 +1,722 @@
 #include "Solver.h"
 #include "Graph.h"
+#include "BfsEngine.h"
+#include "PackedWord.h"
+#include "WorkStealingPool.h"
+#include <chrono>
+#include <cstring>
+#include <unordered_map>
 #include <utility>
+#include <queue>
+#include <tuple>
+#include <functional>
 
- Solver::Solver(const Graph<std::string>& graph) : wordGraph(graph) {}
+ Solver::Solver(const Graph<std::string>& graph) : wordGraph(CompactGraph::fromGraph(graph)) {
+    indexComponents();
+    indexWords(nullptr);
+}
+
+ Solver::Solver(const CompactGraph& graph) : wordGraph(graph) {
+    indexComponents();
+    indexWords(nullptr);
+}
+
+ Solver::Solver(const CompactGraph& graph, std::shared_ptr<const DictionaryIndex> index) : wordGraph(graph) {
+    indexComponents();
+    indexWords(std::move(index));
+}
+
+ void Solver::indexWords(std::shared_ptr<const DictionaryIndex> shared) {
+    const std::size_t n = wordGraph.nodeCount();
+    if (n == 0) return;
+    const std::size_t length = wordGraph.wordLength(0);
+    if (wordGraph.getWordOffsets()[n] != n * length) return;
+
+    // Both keep a length's words sorted back to back, so the index fits only if its bucket
+    // holds the graph's characters byte for byte. A graph built from the index borrows
+    // that very block, and the comparison stops at the pointer check.
+    if (shared && shared->wordCount(length) == n) {
+        const char* bucket = shared->word(length, 0).data();
+        if (bucket == wordGraph.wordData(0) || std::memcmp(bucket, wordGraph.wordData(0), n * length) == 0) {
+            wordIndex = std::move(shared);
+            return;
+        }
+    }
+    std::vector<std::string_view> words;
+    words.reserve(n);
+    for (CompactGraph::NodeId id = 0; id < n; ++id) {
+        words.emplace_back(wordGraph.wordData(id), length);
+    }
+    wordIndex = std::make_shared<const DictionaryIndex>(words);
+    ownsWordIndex = true;
+}
+
+ void Solver::indexComponents() {
+    const std::size_t components = wordGraph.componentCount();
+    componentStart.assign(components + 1, 0);
+    for (std::uint32_t c = 0; c < components; ++c) {
+        componentStart[c + 1] = componentStart[c] + static_cast<std::uint32_t>(wordGraph.componentSize(c));
+    }
+
+    std::vector<std::uint32_t> cursor(componentStart.begin(), componentStart.end() - 1);
+    componentMembers.resize(wordGraph.nodeCount());
+    for (CompactGraph::NodeId id = 0; id < wordGraph.nodeCount(); ++id) {
+        componentMembers[cursor[wordGraph.componentOf(id)]++] = id;
+    }
+
+    componentDegrees.assign(components, 0);
+    for (CompactGraph::NodeId id = 0; id < wordGraph.nodeCount(); ++id) {
+        componentDegrees[wordGraph.componentOf(id)] += wordGraph.degree(id);
+    }
+
+    pairWeights.resize(components);
+    std::uint64_t total = 0;
+    for (std::uint32_t c = 0; c < components; ++c) {
+        const std::uint64_t size = wordGraph.componentSize(c);
+        total += size * (size - 1);
+        pairWeights[c] = total;
+    }
+}
+
+ void Solver::setSearchStrategy(SearchStrategy newStrategy) { strategy = newStrategy; }
 
- std::vector<std::string> Solver::findShortestPath(const std::string& start, const std::string& end) const {
-    std::string startUpper = start;
-    std::string endUpper = end;
-    std::transform(startUpper.begin(), startUpper.end(), startUpper.begin(), ::toupper);
-    std::transform(endUpper.begin(), endUpper.end(), endUpper.begin(), ::toupper);
+ Solver::SearchStrategy Solver::getSearchStrategy() const { return strategy; }
+
+ void Solver::buildLandmarks(std::size_t count) {
+    landmarkDistances.clear();
+    const std::size_t n = wordGraph.nodeCount();
+    if (count == 0 || n == 0) return;
+
+    CompactGraph::NodeId landmark = 0;
+    for (CompactGraph::NodeId id = 1; id < n; ++id) {
+        if (wordGraph.degree(id) > wordGraph.degree(landmark)) landmark = id;
+    }
+
+    // Distance from each word to its nearest landmark, used for farthest-point selection.
+    std::vector<std::uint32_t> nearest(n, CompactGraph::InvalidId);
+    std::unique_ptr<BfsEngine> engine = acquireEngine();
+    while (landmarkDistances.size() < count) {
+        landmarkDistances.push_back(engine->distancesFrom(landmark));
+        const auto& dist = landmarkDistances.back();
+
+        CompactGraph::NodeId farthest = CompactGraph::InvalidId;
+        for (CompactGraph::NodeId id = 0; id < n; ++id) {
+            if (landmarkDistances.front()[id] == CompactGraph::InvalidId) continue;
+            nearest[id] = std::min(nearest[id], dist[id]);
+            if (nearest[id] > 0 && (farthest == CompactGraph::InvalidId || nearest[id] > nearest[farthest])) {
+                farthest = id;
+            }
+        }
+        if (farthest == CompactGraph::InvalidId) break;
+        landmark = farthest;
+    }
+    releaseEngine(std::move(engine));
+}
+
+ std::size_t Solver::getLandmarkCount() const { return landmarkDistances.size(); }
+
+ void Solver::buildHubLabels() { hubLabels = std::make_shared<const HubLabelIndex>(wordGraph); }
+
+ void Solver::setHubLabels(std::shared_ptr<const HubLabelIndex> index) { hubLabels = std::move(index); }
+
+ std::shared_ptr<const HubLabelIndex> Solver::getHubLabels() const { return hubLabels; }
+
+ const CompactGraph& Solver::getGraph() const { return wordGraph; }
+
+ std::size_t Solver::memoryUsage() const {
+    std::size_t bytes = wordGraph.memoryUsage()
+        + componentMembers.size() * sizeof(CompactGraph::NodeId)
+        + componentStart.size() * sizeof(std::uint32_t)
+        + pairWeights.size() * sizeof(std::uint64_t)
+        + (hubLabels ? hubLabels->memoryUsage() : 0)
+        + (ownsWordIndex ? wordIndex->memoryUsage() : 0);
+    {
+        // Each idle engine holds a parent and a depth entry per word.
+        std::lock_guard<std::mutex> lock(engineMutex);
+        bytes += idleEngines.size() * wordGraph.nodeCount() * 2 * sizeof(std::uint32_t);
+    }
+    std::lock_guard<std::mutex> lock(distanceFieldMutex);
+    bytes += distanceFields.size() * wordGraph.nodeCount() * sizeof(std::uint32_t);
+    for (const auto& distances : landmarkDistances) {
+        bytes += distances.size() * sizeof(std::uint32_t);
+    }
+    return bytes;
+}
+
+ std::uint64_t Solver::getSolveCount() const { return solveCount.load(std::memory_order_relaxed); }
+
+ std::uint32_t Solver::lowerBound(CompactGraph::NodeId node, CompactGraph::NodeId target) const {
+    const char* a = wordGraph.wordData(node);
+    const char* b = wordGraph.wordData(target);
+    const std::size_t lengthA = wordGraph.wordLength(node);
+    const std::size_t lengthB = wordGraph.wordLength(target);
+    if (lengthA != lengthB) return CompactGraph::InvalidId;
+
+    std::uint32_t bound = 0;
+    for (std::size_t i = 0; i < lengthA; ++i) {
+        if (a[i] != b[i]) ++bound;
+    }
 
-    if (!wordGraph.contains(startUpper) || !wordGraph.contains(endUpper)) {
+    // Triangle inequality: d(node, target) >= |d(L, target) - d(L, node)|.
+    for (const auto& dist : landmarkDistances) {
+        const bool nodeReached = dist[node] != CompactGraph::InvalidId;
+        const bool targetReached = dist[target] != CompactGraph::InvalidId;
+        if (nodeReached != targetReached) return CompactGraph::InvalidId;
+        if (!nodeReached) continue;
+        std::uint32_t difference = dist[node] > dist[target]
+            ? dist[node] - dist[target] : dist[target] - dist[node];
+        bound = std::max(bound, difference);
+    }
+    return bound;
+}
+
+ std::vector<CompactGraph::NodeId> Solver::aStarPath(CompactGraph::NodeId start,
+    CompactGraph::NodeId end, std::size_t& expandedNodes) const {
+    expandedNodes = 0;
+    if (lowerBound(start, end) == CompactGraph::InvalidId) return {};
+
+    const std::size_t n = wordGraph.nodeCount();
+    std::vector<std::uint32_t> cost(n, CompactGraph::InvalidId);
+    std::vector<CompactGraph::NodeId> parent(n, CompactGraph::InvalidId);
+    std::vector<bool> closed(n, false);
+
+    // Entries are (f, -g, node): ties on f prefer the deeper node, which is closer to the goal.
+    using Entry = std::tuple<std::uint32_t, std::int64_t, CompactGraph::NodeId>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> open;
+
+    cost[start] = 0;
+    parent[start] = start;
+    open.emplace(lowerBound(start, end), 0, start);
+
+    while (!open.empty()) {
+        CompactGraph::NodeId current = std::get<2>(open.top());
+        open.pop();
+        if (closed[current]) continue;
+        closed[current] = true;
+        ++expandedNodes;
+
+        if (current == end) {
+            std::vector<CompactGraph::NodeId> path;
+            for (CompactGraph::NodeId node = end; node != start; node = parent[node]) {
+                path.push_back(node);
+            }
+            path.push_back(start);
+            std::reverse(path.begin(), path.end());
+            return path;
+        }
+
+        const std::uint32_t nextCost = cost[current] + 1;
+        for (const CompactGraph::NodeId* it = wordGraph.neighborsBegin(current);
+            it != wordGraph.neighborsEnd(current); ++it) {
+            const CompactGraph::NodeId neighbor = *it;
+            if (closed[neighbor] || nextCost >= cost[neighbor]) continue;
+            const std::uint32_t bound = lowerBound(neighbor, end);
+            if (bound == CompactGraph::InvalidId) continue;
+            cost[neighbor] = nextCost;
+            parent[neighbor] = current;
+            open.emplace(nextCost + bound, -static_cast<std::int64_t>(nextCost), neighbor);
+        }
+    }
+
+    return {}; ///< No path found
+}
+
+ std::vector<std::string> Solver::findShortestPath(const std::string& start, const std::string& end,
+    SearchStats* stats) const {
+    solveCount.fetch_add(1, std::memory_order_relaxed);
+    if (stats) stats->expandedNodes = 0;
+
+    CompactGraph::NodeId startId = lookup(start);
+    CompactGraph::NodeId endId = lookup(end);
+    if (startId == CompactGraph::InvalidId || endId == CompactGraph::InvalidId
+        || !wordGraph.connected(startId, endId)) {
         return {};
     }
 
-    return wordGraph.shortestPath(startUpper, endUpper);
+    std::size_t expanded = 0;
+    std::vector<CompactGraph::NodeId> ids;
+    switch (strategy) {
+    case SearchStrategy::BreadthFirst:
+        ids = wordGraph.shortestPath(startId, endId, &expanded);
+        break;
+    case SearchStrategy::Bidirectional:
+        ids = wordGraph.bidirectionalShortestPath(startId, endId, &expanded);
+        break;
+    case SearchStrategy::AStar:
+        ids = aStarPath(startId, endId, expanded);
+        break;
+    case SearchStrategy::HubLabels:
+        if (hubLabels) {
+            // The path is walked from label distances without a search, so nothing is expanded.
+            ids = hubLabels->path(wordGraph, startId, endId);
+        }
+        else {
+            ids = wordGraph.bidirectionalShortestPath(startId, endId, &expanded);
+        }
+        break;
+    case SearchStrategy::DirectionOptimizing: {
+        std::unique_ptr<BfsEngine> engine = acquireEngine();
+        ids = engine->shortestPath(startId, endId);
+        expanded = engine->getStats().expandedNodes;
+        releaseEngine(std::move(engine));
+        break;
+    }
+    }
+    if (stats) stats->expandedNodes = expanded;
+
+    std::vector<std::string> path;
+    for (CompactGraph::NodeId id : ids) {
+        path.push_back(wordGraph.wordOf(id));
+    }
+    return path;
+}
+
+ int Solver::distanceBetween(const std::string& start, const std::string& end) const {
+    CompactGraph::NodeId startId = lookup(start);
+    CompactGraph::NodeId endId = lookup(end);
+    if (startId == CompactGraph::InvalidId || endId == CompactGraph::InvalidId
+        || !wordGraph.connected(startId, endId)) {
+        return -1;
+    }
+    if (hubLabels) return static_cast<int>(hubLabels->distance(startId, endId));
+    return static_cast<int>(wordGraph.bidirectionalShortestPath(startId, endId).size()) - 1;
+}
+
+ bool Solver::isReachable(const std::string& start, const std::string& end) const {
+    CompactGraph::NodeId startId = lookup(start);
+    CompactGraph::NodeId endId = lookup(end);
+    return startId != CompactGraph::InvalidId && endId != CompactGraph::InvalidId
+        && wordGraph.connected(startId, endId);
+}
+
+ std::pair<std::string, std::string> Solver::sampleReachablePair(std::mt19937& generator) const {
+    if (pairWeights.empty() || pairWeights.back() == 0) return {};
+
+    std::uniform_int_distribution<std::uint64_t> pickPair(0, pairWeights.back() - 1);
+    const std::size_t component = std::upper_bound(pairWeights.begin(), pairWeights.end(),
+        pickPair(generator)) - pairWeights.begin();
+
+    const CompactGraph::NodeId* members = componentMembers.data() + componentStart[component];
+    const std::uint32_t size = componentStart[component + 1] - componentStart[component];
+    std::uniform_int_distribution<std::uint32_t> pickStart(0, size - 1);
+    std::uniform_int_distribution<std::uint32_t> pickTarget(0, size - 2);
+    const std::uint32_t startIndex = pickStart(generator);
+    std::uint32_t targetIndex = pickTarget(generator);
+    if (targetIndex >= startIndex) ++targetIndex;
+
+    return { wordGraph.wordOf(members[startIndex]), wordGraph.wordOf(members[targetIndex]) };
+}
+
+ CompactGraph::NodeId Solver::lookup(const std::string& word) const {
+    std::string upper = word;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    if (!wordIndex) return wordGraph.idOf(upper);
+    // The index also holds other lengths, whose positions are not IDs of this graph.
+    if (upper.size() != wordGraph.wordLength(0)) return CompactGraph::InvalidId;
+    const std::size_t index = wordIndex->indexOf(upper);
+    return index == DictionaryIndex::NotFound ? CompactGraph::InvalidId : static_cast<CompactGraph::NodeId>(index);
+}
+
+ std::shared_ptr<const Solver::DistanceField> Solver::distanceField(CompactGraph::NodeId target) const {
+    {
+        std::lock_guard<std::mutex> lock(distanceFieldMutex);
+        for (auto it = distanceFields.begin(); it != distanceFields.end(); ++it) {
+            if (it->first == target) {
+                distanceFields.splice(distanceFields.begin(), distanceFields, it);
+                return it->second;
+            }
+        }
+    }
+
+    // Computed outside the lock; two threads racing on a new target both get a valid field.
+    std::unique_ptr<BfsEngine> engine = acquireEngine();
+    auto field = std::make_shared<const DistanceField>(engine->distancesFrom(target));
+    releaseEngine(std::move(engine));
+
+    std::lock_guard<std::mutex> lock(distanceFieldMutex);
+    distanceFields.emplace_front(target, field);
+    if (distanceFields.size() > MaxDistanceFields) distanceFields.pop_back();
+    return field;
+}
+
+ std::unique_ptr<BfsEngine> Solver::acquireEngine() const {
+    {
+        std::lock_guard<std::mutex> lock(engineMutex);
+        if (!idleEngines.empty()) {
+            std::unique_ptr<BfsEngine> engine = std::move(idleEngines.back());
+            idleEngines.pop_back();
+            return engine;
+        }
+    }
+    return std::make_unique<BfsEngine>(wordGraph);
+}
+
+ void Solver::releaseEngine(std::unique_ptr<BfsEngine> engine) const {
+    std::lock_guard<std::mutex> lock(engineMutex);
+    idleEngines.push_back(std::move(engine));
+}
+
+ CompactGraph::NodeId Solver::nextStep(CompactGraph::NodeId current, const DistanceField& field) const {
+    const std::uint32_t distance = field[current];
+    if (distance == 0 || distance == CompactGraph::InvalidId) return CompactGraph::InvalidId;
+    for (const CompactGraph::NodeId* it = wordGraph.neighborsBegin(current);
+        it != wordGraph.neighborsEnd(current); ++it) {
+        if (field[*it] == distance - 1) return *it;
+    }
+    return CompactGraph::InvalidId;
 }
 
  std::pair<std::string, int> Solver::getHint(const std::string& current, const std::string& target) const {
-    auto path = findShortestPath(current, target);
-    if (path.size() < 2) return { "", -1 };
+    CompactGraph::NodeId currentId = lookup(current);
+    CompactGraph::NodeId targetId = lookup(target);
+    if (currentId == CompactGraph::InvalidId || targetId == CompactGraph::InvalidId
+        || !wordGraph.connected(currentId, targetId)) {
+        return { "", -1 };
+    }
 
-    const std::string& nextWord = path[1];
-    for (size_t i = 0; i < current.size(); ++i) {
-        if (current[i] != nextWord[i]) {
-            return { nextWord, static_cast<int>(i) };
+    CompactGraph::NodeId next = nextStep(currentId, *distanceField(targetId));
+    if (next == CompactGraph::InvalidId) return { "", -1 };
+
+    const char* from = wordGraph.wordData(currentId);
+    const char* to = wordGraph.wordData(next);
+    for (std::size_t i = 0; i < wordGraph.wordLength(next); ++i) {
+        if (from[i] != to[i]) {
+            return { wordGraph.wordOf(next), static_cast<int>(i) };
         }
     }
     return { "", -1 };
 }
+
+ int Solver::distanceToTarget(const std::string& word, const std::string& target) const {
+    CompactGraph::NodeId wordId = lookup(word);
+    CompactGraph::NodeId targetId = lookup(target);
+    if (wordId == CompactGraph::InvalidId || targetId == CompactGraph::InvalidId
+        || !wordGraph.connected(wordId, targetId)) {
+        return -1;
+    }
+    return static_cast<int>((*distanceField(targetId))[wordId]);
+}
+
+ bool Solver::isOptimalMove(const std::string& from, const std::string& to, const std::string& target) const {
+    CompactGraph::NodeId fromId = lookup(from);
+    CompactGraph::NodeId toId = lookup(to);
+    CompactGraph::NodeId targetId = lookup(target);
+    if (fromId == CompactGraph::InvalidId || toId == CompactGraph::InvalidId
+        || targetId == CompactGraph::InvalidId || !wordGraph.connected(fromId, targetId)) {
+        return false;
+    }
+    if (!std::binary_search(wordGraph.neighborsBegin(fromId), wordGraph.neighborsEnd(fromId), toId)) {
+        return false;
+    }
+    const DistanceField& field = *distanceField(targetId);
+    return field[toId] + 1 == field[fromId];
+}
+
+ Solver::MoveCheck Solver::validateMove(const std::string& current, const std::string& next) const {
+    if (current.size() != next.size()) return MoveCheck::LengthMismatch;
+    if (wordIndex && next.size() != wordGraph.wordLength(0)) return MoveCheck::LengthMismatch;
+    CompactGraph::NodeId currentId = lookup(current);
+    CompactGraph::NodeId nextId = lookup(next);
+    if (currentId == CompactGraph::InvalidId) return MoveCheck::UnknownCurrent;
+    if (nextId == currentId) return MoveCheck::SameWord;
+    if (nextId != CompactGraph::InvalidId) {
+        // Two dictionary words are one letter apart exactly when the graph links them.
+        return std::binary_search(wordGraph.neighborsBegin(currentId), wordGraph.neighborsEnd(currentId), nextId)
+            ? MoveCheck::Legal : MoveCheck::NotOneLetter;
+    }
+    // Unknown words are only compared letter by letter, to tell the player which rule failed.
+    std::string upper = next;
+    std::transform(upper.begin(), upper.end(), upper.begin(), ::toupper);
+    if (upper == wordGraph.wordOf(currentId)) return MoveCheck::SameWord;
+    return PackedWord::differsByOneLetter(wordGraph.wordOf(currentId), upper)
+        ? MoveCheck::NotInDictionary : MoveCheck::NotOneLetter;
+}
+
+ std::vector<std::string> Solver::pathToTarget(const std::string& start, const std::string& target) const {
+    CompactGraph::NodeId current = lookup(start);
+    CompactGraph::NodeId targetId = lookup(target);
+    if (current == CompactGraph::InvalidId || targetId == CompactGraph::InvalidId
+        || !wordGraph.connected(current, targetId)) {
+        return {};
+    }
+
+    std::shared_ptr<const DistanceField> field = distanceField(targetId);
+    std::vector<std::string> path = { wordGraph.wordOf(current) };
+    while (current != targetId) {
+        current = nextStep(current, *field);
+        path.push_back(wordGraph.wordOf(current));
+    }
+    return path;
+}
+
+ LadderDag Solver::optimalLadders(const std::string& start, const std::string& target) const {
+    CompactGraph::NodeId startId = lookup(start);
+    CompactGraph::NodeId targetId = lookup(target);
+    if (startId == CompactGraph::InvalidId || targetId == CompactGraph::InvalidId
+        || !wordGraph.connected(startId, targetId)) {
+        return {};
+    }
+    return LadderDag(wordGraph, startId, *distanceField(targetId));
+}
+
+ void Solver::SearchScratch::reset(std::size_t n) {
+    if (seen[0].size() != n || ++round == 0) {
+        for (int side = 0; side < 2; ++side) {
+            seen[side].assign(n, 0);
+            parent[side].resize(n);
+            depth[side].resize(n);
+        }
+        round = 1;
+    }
+}
+
+ std::vector<CompactGraph::NodeId> Solver::scratchPath(CompactGraph::NodeId start, CompactGraph::NodeId end,
+    SearchScratch& scratch) const {
+    if (start == end) return { start };
+    scratch.reset(wordGraph.nodeCount());
+    const std::uint32_t round = scratch.round;
+
+    const CompactGraph::NodeId roots[2] = { start, end };
+    for (int side = 0; side < 2; ++side) {
+        scratch.frontier[side].assign(1, roots[side]);
+        scratch.seen[side][roots[side]] = round;
+        scratch.parent[side][roots[side]] = roots[side];
+        scratch.depth[side][roots[side]] = 0;
+    }
+
+    while (!scratch.frontier[0].empty() && !scratch.frontier[1].empty()) {
+        const int side = scratch.frontier[0].size() <= scratch.frontier[1].size() ? 0 : 1;
+        const int other = 1 - side;
+
+        scratch.next.clear();
+        std::uint32_t bestLength = 0;
+        CompactGraph::NodeId meetOwn = CompactGraph::InvalidId;
+        CompactGraph::NodeId meetOther = CompactGraph::InvalidId;
+        for (CompactGraph::NodeId current : scratch.frontier[side]) {
+            const std::uint32_t depth = scratch.depth[side][current];
+            scratch.scannedEdges += wordGraph.degree(current);
+            for (const CompactGraph::NodeId* it = wordGraph.neighborsBegin(current);
+                it != wordGraph.neighborsEnd(current); ++it) {
+                const CompactGraph::NodeId neighbor = *it;
+                if (scratch.seen[other][neighbor] == round) {
+                    std::uint32_t length = depth + 1 + scratch.depth[other][neighbor];
+                    if (meetOwn == CompactGraph::InvalidId || length < bestLength) {
+                        bestLength = length;
+                        meetOwn = current;
+                        meetOther = neighbor;
+                    }
+                }
+                if (scratch.seen[side][neighbor] != round) {
+                    scratch.seen[side][neighbor] = round;
+                    scratch.parent[side][neighbor] = current;
+                    scratch.depth[side][neighbor] = depth + 1;
+                    scratch.next.push_back(neighbor);
+                }
+            }
+        }
+
+        if (meetOwn != CompactGraph::InvalidId) {
+            const CompactGraph::NodeId meetForward = side == 0 ? meetOwn : meetOther;
+            const CompactGraph::NodeId meetBackward = side == 0 ? meetOther : meetOwn;
+
+            std::vector<CompactGraph::NodeId> path;
+            for (CompactGraph::NodeId node = meetForward; node != start; node = scratch.parent[0][node]) {
+                path.push_back(node);
+            }
+            path.push_back(start);
+            std::reverse(path.begin(), path.end());
+            for (CompactGraph::NodeId node = meetBackward; node != end; node = scratch.parent[1][node]) {
+                path.push_back(node);
+            }
+            path.push_back(end);
+            return path;
+        }
+
+        scratch.frontier[side].swap(scratch.next);
+    }
+    return {};
+}
+
+ void Solver::scratchTree(CompactGraph::NodeId source, SearchScratch& scratch) const {
+    scratch.reset(wordGraph.nodeCount());
+    const std::uint32_t round = scratch.round;
+
+    // Side 1 only marks the words still to be reached.
+    std::size_t remaining = 0;
+    for (CompactGraph::NodeId target : scratch.targets) {
+        if (target != source && scratch.seen[1][target] != round) {
+            scratch.seen[1][target] = round;
+            ++remaining;
+        }
+    }
+
+    std::vector<CompactGraph::NodeId>& queue = scratch.frontier[0];
+    queue.assign(1, source);
+    scratch.seen[0][source] = round;
+    scratch.parent[0][source] = source;
+    scratch.depth[0][source] = 0;
+    for (std::size_t head = 0; head < queue.size() && remaining > 0; ++head) {
+        const CompactGraph::NodeId current = queue[head];
+        scratch.scannedEdges += wordGraph.degree(current);
+        for (const CompactGraph::NodeId* it = wordGraph.neighborsBegin(current);
+            it != wordGraph.neighborsEnd(current); ++it) {
+            if (scratch.seen[0][*it] == round) continue;
+            scratch.seen[0][*it] = round;
+            scratch.parent[0][*it] = current;
+            scratch.depth[0][*it] = scratch.depth[0][current] + 1;
+            queue.push_back(*it);
+            if (scratch.seen[1][*it] == round) --remaining;
+        }
+    }
+}
+
+ std::vector<Solver::BatchResult> Solver::solveBatch(const std::vector<BatchQuery>& queries,
+    const BatchOptions& options) const {
+    return solveBatch(queries.data(), queries.size(), options);
+}
+
+ std::vector<Solver::BatchResult> Solver::solveBatch(const BatchQuery* queries, std::size_t count,
+    const BatchOptions& options) const {
+    using Clock = std::chrono::steady_clock;
+    solveCount.fetch_add(count, std::memory_order_relaxed);
+    std::vector<BatchResult> results(count);
+
+    // Resolve the words; unknown and unreachable queries keep the default result.
+    std::vector<CompactGraph::NodeId> starts(count, CompactGraph::InvalidId);
+    std::vector<CompactGraph::NodeId> targets(count, CompactGraph::InvalidId);
+    std::unordered_map<CompactGraph::NodeId, std::uint32_t> endpointUses;
+    for (std::size_t i = 0; i < count; ++i) {
+        CompactGraph::NodeId startId = lookup(queries[i].start);
+        CompactGraph::NodeId targetId = lookup(queries[i].target);
+        if (startId == CompactGraph::InvalidId || targetId == CompactGraph::InvalidId
+            || !wordGraph.connected(startId, targetId)) {
+            continue;
+        }
+        starts[i] = startId;
+        targets[i] = targetId;
+        ++endpointUses[startId];
+        ++endpointUses[targetId];
+    }
+
+    WorkStealingPool pool(options.threadCount);
+    std::vector<SearchScratch> scratches(pool.getThreadCount());
+    const bool labelDistances = hubLabels && !options.withPaths;
+
+    std::vector<std::uint32_t> valid;
+    for (std::size_t i = 0; i < count; ++i) {
+        if (starts[i] != CompactGraph::InvalidId) valid.push_back(static_cast<std::uint32_t>(i));
+    }
+    auto searchOne = [&](std::uint32_t query, SearchScratch& scratch) {
+        return hubLabels ? hubLabels->path(wordGraph, starts[query], targets[query])
+            : scratchPath(starts[query], targets[query], scratch);
+    };
+
+    // Root each query at its more popular endpoint and group queries by root.
+    std::vector<CompactGraph::NodeId> roots(count, CompactGraph::InvalidId);
+    std::vector<std::uint32_t> order = valid;
+    for (std::uint32_t i : valid) {
+        roots[i] = endpointUses[targets[i]] > endpointUses[starts[i]] ? targets[i] : starts[i];
+    }
+    std::stable_sort(order.begin(), order.end(), [&roots](std::uint32_t a, std::uint32_t b) {
+        return roots[a] < roots[b];
+    });
+    std::vector<std::pair<std::size_t, std::size_t>> groups;
+    std::size_t largest = 0;
+    for (std::size_t begin = 0, end; begin < order.size(); begin = end) {
+        end = begin + 1;
+        while (end < order.size() && roots[order[end]] == roots[order[begin]]) ++end;
+        groups.emplace_back(begin, end);
+        if (end - begin > groups[largest].second - groups[largest].first) largest = groups.size() - 1;
+    }
+
+    // Costs are counted in adjacency entries read rather than timed, so the same batch
+    // always picks the same strategy and returns the same ladders. Label queries read no
+    // adjacency, so with labels every query is answered on its own.
+    double searchEdges = 0;
+    if (!hubLabels && !groups.empty() && groups[largest].second - groups[largest].first > 1) {
+        SearchScratch& scratch = scratches[0];
+        const std::size_t samples = std::min(CostSamples, valid.size());
+        scratch.scannedEdges = 0;
+        for (std::size_t k = 0; k < samples; ++k) searchOne(valid[k * valid.size() / samples], scratch);
+        searchEdges = static_cast<double>(scratch.scannedEdges) / samples;
+    }
+
+    struct Task {
+        std::size_t begin; ///< First position in order.
+        std::size_t end;   ///< One past the last position in order.
+        bool tree;         ///< Whether one BFS tree answers all of them.
+    };
+    std::vector<Task> tasks;
+    for (const auto& group : groups) {
+        // A tree is costed as if it had to read its whole component.
+        const std::size_t size = group.second - group.first;
+        const double treeEdges
+            = static_cast<double>(componentDegrees[wordGraph.componentOf(roots[order[group.first]])]);
+        if (size > 1 && searchEdges > 0 && size * searchEdges >= treeEdges) {
+            tasks.push_back({ group.first, group.second, true });
+        }
+        else {
+            for (std::size_t i = group.first; i < group.second; ++i) tasks.push_back({ i, i + 1, false });
+        }
+    }
+    // Large trees first, so the pool's initial split spreads them over the workers.
+    std::stable_sort(tasks.begin(), tasks.end(), [](const Task& a, const Task& b) {
+        return a.end - a.begin > b.end - b.begin;
+    });
+
+    auto toWords = [this](const std::vector<CompactGraph::NodeId>& ids) {
+        std::vector<std::string> words;
+        words.reserve(ids.size());
+        for (CompactGraph::NodeId id : ids) words.push_back(wordGraph.wordOf(id));
+        return words;
+    };
+
+    pool.run(tasks.size(), [&](unsigned worker, std::size_t taskIndex) {
+        const Task& task = tasks[taskIndex];
+        SearchScratch& scratch = scratches[worker];
+        const auto started = Clock::now();
+
+        if (!task.tree) {
+            const std::uint32_t query = order[task.begin];
+            BatchResult& result = results[query];
+            if (labelDistances) {
+                result.distance = static_cast<int>(hubLabels->distance(starts[query], targets[query]));
+            }
+            else {
+                std::vector<CompactGraph::NodeId> ids = searchOne(query, scratch);
+                result.distance = static_cast<int>(ids.size()) - 1;
+                if (options.withPaths) result.path = toWords(ids);
+            }
+            result.microseconds = std::chrono::duration<float, std::micro>(Clock::now() - started).count();
+            return;
+        }
+
+        const CompactGraph::NodeId root = roots[order[task.begin]];
+        scratch.targets.clear();
+        for (std::size_t i = task.begin; i < task.end; ++i) {
+            const std::uint32_t query = order[i];
+            scratch.targets.push_back(starts[query] == root ? targets[query] : starts[query]);
+        }
+        scratchTree(root, scratch);
+
+        std::vector<CompactGraph::NodeId> ids;
+        for (std::size_t i = task.begin; i < task.end; ++i) {
+            const std::uint32_t query = order[i];
+            const CompactGraph::NodeId other = scratch.targets[i - task.begin];
+            results[query].distance = static_cast<int>(scratch.depth[0][other]);
+            if (!options.withPaths) continue;
+
+            // The tree walk runs from the far endpoint back to the root.
+            ids.clear();
+            for (CompactGraph::NodeId node = other; node != root; node = scratch.parent[0][node]) {
+                ids.push_back(node);
+            }
+            ids.push_back(root);
+            if (starts[query] == root) std::reverse(ids.begin(), ids.end());
+            results[query].path = toWords(ids);
+        }
+        const float elapsed = std::chrono::duration<float, std::micro>(Clock::now() - started).count();
+        for (std::size_t i = task.begin; i < task.end; ++i) results[order[i]].microseconds = elapsed;
+    });
+    return results;
+}
@@ -1,5 +1,16 @@
 #pragma once
 #include "Graph.h"
+#include "BfsEngine.h"
+#include "CompactGraph.h"
+#include "DictionaryIndex.h"
+#include "HubLabelIndex.h"
+#include "LadderDag.h"
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <random>
 #include <string>
 #include <vector>
 #include <algorithm>
@@ -10,47 +21,501 @@
  * @ingroup Core Core Logic
  * 
  * The Solver class uses a pre-built word graph to find shortest paths between words
- * and to generate hints for the player.
+ * and to generate hints for the player. Internally the graph is kept in compact
+ * CSR form, so searches walk flat integer arrays.
+ *
+ * Words are looked up through a hashed DictionaryIndex whose positions equal the graph's
+ * node IDs, so turning a word into an ID costs one hash probe instead of a binary search.
+ *
+ * Within a game the target word stays fixed, so hints, remaining distances and
+ * optimal-move checks are answered from a BFS distance field computed once per target
+ * and cached. Each of those queries then only scans the neighbors of one word.
  */
 
 class Solver {
+public:
+    /**
+     * @brief Search algorithm used to answer shortest-path queries.
+     */
+    enum class SearchStrategy {
+        BreadthFirst,        ///< One-sided BFS from the start word.
+        Bidirectional,       ///< BFS grown from both ends, expanding the smaller frontier.
+        AStar,               ///< A* guided by Hamming distance and optional landmark bounds.
+        DirectionOptimizing, ///< Bitset BFS switching between top-down and bottom-up levels.
+        HubLabels            ///< Label merges on the hub label index; bidirectional BFS without one.
+    };
+
+    /**
+     * @brief Statistics collected while answering a single query.
+     */
+    struct SearchStats {
+        /// Number of nodes taken off the open list or queue. Always 0 for hub label
+        /// queries, which walk the path from label distances instead of searching.
+        std::size_t expandedNodes = 0;
+    };
+
+    /**
+     * @brief One query of a batch.
+     */
+    struct BatchQuery {
+        std::string start;  ///< The word to start from.
+        std::string target; ///< The target word.
+    };
+
+    /**
+     * @brief The answer to one query of a batch.
+     */
+    struct BatchResult {
+        int distance = -1;             ///< Number of moves, or -1 if unknown or unreachable.
+        std::vector<std::string> path; ///< A shortest ladder, empty if none or not requested.
+        float microseconds = 0;        ///< Time of the search that answered the query; shared
+                                       ///< by all queries answered by the same BFS tree.
+    };
+
+    /**
+     * @brief Outcome of validateMove().
+     */
+    enum class MoveCheck {
+        Legal,            ///< Both words are in the dictionary and one letter apart.
+        SameWord,         ///< The next word equals the current one.
+        LengthMismatch,   ///< The words have different lengths, or not the graph's length.
+        NotOneLetter,     ///< The words differ in more than one letter.
+        NotInDictionary,  ///< The next word is not a dictionary word of this length.
+        UnknownCurrent    ///< The current word is not in the graph.
+    };
+
+    /**
+     * @brief How solveBatch() runs.
+     */
+    struct BatchOptions {
+        unsigned threadCount = 0; ///< Worker threads; 0 uses hardware concurrency.
+        bool withPaths = true;    ///< Whether to reconstruct ladders or only measure distances.
+    };
+
 private:
     /**
      * @brief The word graph used for transformations.
      *
      * Each node is a word, and edges connect words that differ by one letter.
      */
-    Graph<std::string> wordGraph;
+    CompactGraph wordGraph;
+
+    /**
+     * @brief The algorithm used by findShortestPath().
+     */
+    SearchStrategy strategy = SearchStrategy::Bidirectional;
+
+    /**
+     * @brief BFS distances from each landmark to every word, used by the ALT bound.
+     *
+     * Unreachable words are marked with CompactGraph::InvalidId.
+     */
+    std::vector<std::vector<std::uint32_t>> landmarkDistances;
+
+    /**
+     * @brief Word IDs grouped by component; component @c c occupies
+     * @c componentMembers[componentStart[c] .. componentStart[c + 1]).
+     */
+    std::vector<CompactGraph::NodeId> componentMembers;
+    std::vector<std::uint32_t> componentStart;
+
+    /**
+     * @brief Running total of s * (s - 1) over components of size s, in label order.
+     *
+     * Each term counts the ordered pairs of distinct words inside one component, so
+     * sampling a component against these weights makes every reachable pair equally likely.
+     */
+    std::vector<std::uint64_t> pairWeights;
+
+    /**
+     * @brief Sum of the degrees of the words of each component.
+     *
+     * This is the number of adjacency entries a BFS tree covering the component reads,
+     * which solveBatch() uses to estimate the cost of a tree.
+     */
+    std::vector<std::uint64_t> componentDegrees;
+
+    /**
+     * @brief Hashed word lookup; a word's index in its bucket is its node ID.
+     *
+     * Either shared with the GraphCache that built the solver or built from the graph's
+     * own words. Null when the graph mixes word lengths, and lookups fall back to
+     * CompactGraph::idOf().
+     */
+    std::shared_ptr<const DictionaryIndex> wordIndex;
+
+    /**
+     * @brief Whether wordIndex was built by this solver, and so counts towards memoryUsage().
+     */
+    bool ownsWordIndex = false;
+
+    /**
+     * @brief Optional exact distance oracle, shared between solvers of the same graph.
+     */
+    std::shared_ptr<const HubLabelIndex> hubLabels;
+
+    /**
+     * @brief Groups words by component and fills the pair weights.
+     */
+    void indexComponents();
+
+    /**
+     * @brief Sets up wordIndex, reusing a shared index when its bucket holds exactly the graph's words.
+     */
+    void indexWords(std::shared_ptr<const DictionaryIndex> shared);
+
+    /**
+     * @brief Distance from every word to one target word, InvalidId where unreachable.
+     */
+    using DistanceField = std::vector<std::uint32_t>;
+
+    /**
+     * @brief Number of targets whose distance fields are kept.
+     */
+    static constexpr std::size_t MaxDistanceFields = 8;
+
+    /**
+     * @brief Recently used distance fields keyed by target ID, most recent first.
+     */
+    mutable std::list<std::pair<CompactGraph::NodeId, std::shared_ptr<const DistanceField>>> distanceFields;
+
+    /**
+     * @brief Guards distanceFields, so a shared Solver can serve several threads.
+     */
+    mutable std::mutex distanceFieldMutex;
+
+    /**
+     * @brief Search engines not in use by any thread, kept so later searches reuse their buffers.
+     */
+    mutable std::vector<std::unique_ptr<BfsEngine>> idleEngines;
+
+    /**
+     * @brief Guards idleEngines.
+     */
+    mutable std::mutex engineMutex;
+
+    /**
+     * @brief Ladder queries answered by findShortestPath() and solveBatch() so far.
+     */
+    mutable std::atomic<std::uint64_t> solveCount{ 0 };
+
+    /**
+     * @brief Takes an idle engine, creating one only if all are in use by other threads.
+     */
+    std::unique_ptr<BfsEngine> acquireEngine() const;
+
+    /**
+     * @brief Returns an engine taken with acquireEngine() for later searches.
+     */
+    void releaseEngine(std::unique_ptr<BfsEngine> engine) const;
+
+    /**
+     * @brief Returns the cached distance field of a target, computing it on first use.
+     */
+    std::shared_ptr<const DistanceField> distanceField(CompactGraph::NodeId target) const;
+
+    /**
+     * @brief Returns the lowest-ID neighbor of a word that is one step closer to the target.
+     *
+     * @return The neighbor, or InvalidId if the word is the target or cannot reach it.
+     */
+    CompactGraph::NodeId nextStep(CompactGraph::NodeId current, const DistanceField& field) const;
+
+    /**
+     * @brief Looks up the ID of a word after converting it to upper case.
+     */
+    CompactGraph::NodeId lookup(const std::string& word) const;
+
+    /**
+     * @brief Computes an admissible lower bound on the distance between two words.
+     *
+     * @param node The word being evaluated.
+     * @param target The target word.
+     * @return The larger of the Hamming distance and the landmark bound,
+     *         or CompactGraph::InvalidId if a landmark proves target unreachable.
+     */
+    std::uint32_t lowerBound(CompactGraph::NodeId node, CompactGraph::NodeId target) const;
+
+    /**
+     * @brief Finds the shortest path between two words using A*.
+     *
+     * @param start ID of the start word.
+     * @param end ID of the target word.
+     * @param expandedNodes Receives the number of nodes expanded.
+     * @return The IDs along the shortest path, or an empty vector if no path exists.
+     */
+    std::vector<CompactGraph::NodeId> aStarPath(CompactGraph::NodeId start,
+        CompactGraph::NodeId end, std::size_t& expandedNodes) const;
+
+    /**
+     * @brief Search buffers owned by one batch worker and reused across its queries.
+     *
+     * A word counts as visited by side s when seen[s] holds the current round, so starting
+     * a new search only increments the round instead of clearing the arrays.
+     */
+    struct SearchScratch {
+        std::vector<std::uint32_t> seen[2];        ///< Round in which each word was reached per side.
+        std::vector<CompactGraph::NodeId> parent[2]; ///< BFS parent per side.
+        std::vector<std::uint32_t> depth[2];       ///< BFS depth per side.
+        std::vector<CompactGraph::NodeId> frontier[2]; ///< Current level per side.
+        std::vector<CompactGraph::NodeId> next;    ///< Level being built.
+        std::vector<CompactGraph::NodeId> targets; ///< Words a shared BFS tree must reach.
+        std::size_t scannedEdges = 0;              ///< Adjacency entries read by searches so far.
+        std::uint32_t round = 0;                   ///< Stamp of the current search.
+
+        /**
+         * @brief Starts a new search on a graph of n words.
+         */
+        void reset(std::size_t n);
+    };
+
+    /**
+     * @brief Bidirectional BFS like CompactGraph::bidirectionalShortestPath, on reused buffers.
+     */
+    std::vector<CompactGraph::NodeId> scratchPath(CompactGraph::NodeId start, CompactGraph::NodeId end,
+        SearchScratch& scratch) const;
+
+    /**
+     * @brief Grows one BFS tree from source until every word in scratch.targets is reached.
+     *
+     * Afterwards parent[0] and depth[0] of the scratch hold the tree.
+     */
+    void scratchTree(CompactGraph::NodeId source, SearchScratch& scratch) const;
+
+    /**
+     * @brief Number of bidirectional searches solveBatch() samples to estimate their cost.
+     */
+    static constexpr std::size_t CostSamples = 16;
 
 public:
     /**
      * @brief Constructs a Solver with the given word graph.
      *
+     * The graph is frozen into a CompactGraph on construction.
+     *
      * @param graph A Graph object where each node is a valid dictionary word.
      */
     Solver(const Graph<std::string>& graph);
 
+    /**
+     * @brief Constructs a Solver on an already compacted word graph.
+     *
+     * The graph's arrays are shared, not copied, so any number of solvers and threads can
+     * search one graph while its builder or cache keeps it too.
+     *
+     * @param graph A CompactGraph where each node is a valid dictionary word.
+     */
+    Solver(const CompactGraph& graph);
+
+    /**
+     * @brief Constructs a Solver that looks words up in an existing dictionary index.
+     *
+     * The index is used only if its bucket for the graph's word length holds exactly the
+     * graph's words; otherwise the solver indexes the words itself.
+     *
+     * @param graph A CompactGraph of words of one length.
+     * @param index The dictionary the graph was built from.
+     */
+    Solver(const CompactGraph& graph, std::shared_ptr<const DictionaryIndex> index);
+
+    /**
+     * @brief Selects the algorithm used by findShortestPath() and getHint().
+     *
+     * @param newStrategy The search strategy to use.
+     */
+    void setSearchStrategy(SearchStrategy newStrategy);
+
+    /**
+     * @brief Returns the algorithm currently used for shortest-path queries.
+     */
+    SearchStrategy getSearchStrategy() const;
+
+    /**
+     * @brief Precomputes landmark distances to tighten the A* heuristic (ALT).
+     *
+     * The first landmark is the word with the most neighbors; each further landmark is
+     * the word in its component that is farthest from all landmarks chosen so far.
+     * Passing 0 removes the landmarks and leaves only the Hamming bound.
+     *
+     * @param count Number of landmarks to select.
+     */
+    void buildLandmarks(std::size_t count);
+
+    /**
+     * @brief Returns the number of landmarks currently in use.
+     */
+    std::size_t getLandmarkCount() const;
+
+    /**
+     * @brief Builds a hub label index over the graph, enabling constant-time distances.
+     */
+    void buildHubLabels();
+
+    /**
+     * @brief Attaches a hub label index, for example one loaded from disk.
+     *
+     * @param index An index built for this solver's graph, or nullptr to detach.
+     */
+    void setHubLabels(std::shared_ptr<const HubLabelIndex> index);
+
+    /**
+     * @brief Returns the attached hub label index, or nullptr if there is none.
+     */
+    std::shared_ptr<const HubLabelIndex> getHubLabels() const;
+
+    /**
+     * @brief Returns the word graph the solver searches.
+     */
+    const CompactGraph& getGraph() const;
+
+    /**
+     * @brief Returns the approximate number of bytes held by the graph, landmark tables,
+     *        hub labels and cached distance fields.
+     */
+    std::size_t memoryUsage() const;
+
+    /**
+     * @brief Returns the number of ladder queries answered so far.
+     *
+     * Every findShortestPath() call and every query of a solveBatch() call counts once,
+     * whether or not a ladder was found.
+     */
+    std::uint64_t getSolveCount() const;
+
+    /**
+     * @brief Checks whether one word can be transformed into another, in constant time.
+     *
+     * @param start The word to start from.
+     * @param end The target word.
+     * @return True if both words are in the graph and lie in the same component.
+     */
+    bool isReachable(const std::string& start, const std::string& end) const;
+
+    /**
+     * @brief Picks a random start and target word that are connected by a ladder.
+     *
+     * Every ordered pair of distinct, mutually reachable words is equally likely.
+     *
+     * @param generator Source of randomness.
+     * @return The start and target words, or two empty strings if no component has
+     *         at least two words.
+     */
+    std::pair<std::string, std::string> sampleReachablePair(std::mt19937& generator) const;
+
+    /**
+     * @brief Returns the length of the shortest ladder between two words.
+     *
+     * Answered by the hub label index when one is attached, and by a search otherwise.
+     *
+     * @param start The word to start from.
+     * @param end The target word.
+     * @return The number of moves, or -1 if either word is unknown or no path exists.
+     */
+    int distanceBetween(const std::string& start, const std::string& end) const;
+
     /**
      * @brief Finds the shortest transformation path between two words.
      *
-     * Uses Breadth-First Search (BFS) internally to compute the path.
+     * Uses the selected search strategy (bidirectional BFS by default) to compute the path.
+     * Words in different components are rejected without searching.
      *
      * @param start The word to start from.
      * @param end The target word to reach.
+     * @param stats Optional output receiving search statistics such as expanded nodes.
      * @return A vector of words representing the shortest path.
      *         Returns an empty vector if no path exists.
      */
     std::vector<std::string> findShortestPath(const std::string& start,
-        const std::string& end) const;
+        const std::string& end, SearchStats* stats = nullptr) const;
 
     /**
      * @brief Provides a hint by returning the next best word in the path from current to target.
      *
+     * Answered from the target's distance field by scanning the neighbors of current.
+     *
      * @param current The current word.
      * @param target The target word.
      * @return A pair containing:
      *         - the next word in the optimal path (or empty string if no path exists),
-     *         - the total number of moves in the optimal path.
+     *         - the position of the letter that changes (or -1).
      */
     std::pair<std::string, int> getHint(const std::string& current, const std::string& target) const;
+
+    /**
+     * @brief Returns the number of moves still needed to reach the target.
+     *
+     * @param word The word to measure from.
+     * @param target The target word.
+     * @return The remaining distance, or -1 if either word is unknown or no path exists.
+     */
+    int distanceToTarget(const std::string& word, const std::string& target) const;
+
+    /**
+     * @brief Checks whether a move brings the player one step closer to the target.
+     *
+     * @param from The word before the move.
+     * @param to The word after the move.
+     * @param target The target word.
+     * @return True if @p to is a neighbor of @p from on some shortest path to the target.
+     */
+    bool isOptimalMove(const std::string& from, const std::string& to, const std::string& target) const;
+
+    /**
+     * @brief Checks whether a move from one word to another is a legal ladder step.
+     *
+     * Costs one hashed lookup per word and a binary search of the current word's sorted
+     * neighbor IDs. Words are compared case-insensitively.
+     *
+     * @param current The word before the move.
+     * @param next The word the player wants to move to.
+     * @return MoveCheck::Legal, or the first check the move fails.
+     */
+    MoveCheck validateMove(const std::string& current, const std::string& next) const;
+
+    /**
+     * @brief Follows the target's distance field from a word to the target.
+     *
+     * @param start The word to start from.
+     * @param target The target word.
+     * @return A shortest path from start to target, or an empty vector if none exists.
+     */
+    std::vector<std::string> pathToTarget(const std::string& start, const std::string& target) const;
+
+    /**
+     * @brief Builds the DAG of all optimal ladders between two words.
+     *
+     * The DAG is derived from the target's cached distance field. It counts the ladders
+     * exactly, samples them uniformly, and enumerates them lazily.
+     *
+     * @param start The word to start from.
+     * @param target The target word.
+     * @return The DAG, empty if either word is unknown or no path exists.
+     */
+    LadderDag optimalLadders(const std::string& start, const std::string& target) const;
+
+    /**
+     * @brief Answers many queries at once on a work-stealing thread pool.
+     *
+     * Queries sharing an endpoint are grouped, and one BFS tree rooted at that word
+     * answers the whole group when it reads fewer adjacency entries than separate
+     * searches would. A search's cost is the mean number of entries read by a few
+     * sample searches of the batch, and a tree's is its whole component, so the choice,
+     * and with it every returned ladder, depends only on the batch and the graph. The
+     * remaining queries each run a bidirectional BFS, or a label query when a hub label
+     * index is attached. Each worker keeps its own search buffers for all of its
+     * queries, so a batch allocates only for its results. Distance-only batches are
+     * answered from the hub label index when one is attached.
+     *
+     * @param queries The first query.
+     * @param count Number of queries.
+     * @param options Threads and whether paths are needed.
+     * @return One result per query, in the same order.
+     */
+    std::vector<BatchResult> solveBatch(const BatchQuery* queries, std::size_t count,
+        const BatchOptions& options) const;
+
+    /**
+     * @brief Answers all queries of a vector at once; see the overload above.
+     */
+    std::vector<BatchResult> solveBatch(const std::vector<BatchQuery>& queries, const BatchOptions& options) const;
 };
@@ -0,0 +1,24 @@
+#include "WordListModel.h"
+#include "DictionaryIndex.h"
+
+WordListModel::WordListModel(QObject* parent) : QAbstractListModel(parent) {}
+
+void WordListModel::setWords(std::shared_ptr<const DictionaryIndex> index, std::size_t length) {
+    beginResetModel();
+    dictionary = std::move(index);
+    wordLength = length;
+    endResetModel();
+}
+
+int WordListModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || !dictionary) return 0;
+    return static_cast<int>(dictionary->wordCount(wordLength));
+}
+
+QVariant WordListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount() || (role != Qt::DisplayRole && role != Qt::EditRole)) {
+        return QVariant();
+    }
+    const std::string_view word = dictionary->word(wordLength, static_cast<std::size_t>(index.row()));
+    return QString::fromLatin1(word.data(), static_cast<int>(word.size()));
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <QAbstractListModel>
+#include <cstddef>
+#include <memory>
+
+class DictionaryIndex;
+
+/**
+ * @class WordListModel
+ * @brief A read-only list model over the words of one length in a DictionaryIndex.
+ * @ingroup UI UI Components
+ *
+ * Rows are the bucket's words in lexicographic order and are converted to QString only
+ * when a view asks for them, so combo boxes show the dictionary without keeping their
+ * own copy of every word. One model can back several views.
+ */
+
+class WordListModel : public QAbstractListModel {
+public:
+    /**
+     * @brief Constructs an empty model.
+     * @param parent Owner of the model.
+     */
+    explicit WordListModel(QObject* parent = nullptr);
+
+    /**
+     * @brief Shows the words of one length, or nothing if the index is null.
+     *
+     * @param index The dictionary to read from.
+     * @param length Word length to list.
+     */
+    void setWords(std::shared_ptr<const DictionaryIndex> index, std::size_t length);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+private:
+    std::shared_ptr<const DictionaryIndex> dictionary; ///< Index holding the words, if any
+    std::size_t wordLength = 0;                        ///< Length of the listed words
+};
@@ -0,0 +1,100 @@
+#include "WorkStealingPool.h"
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief The tasks still owned by one worker.
+ */
+struct TaskRange {
+    std::mutex mutex;
+    std::size_t begin = 0;
+    std::size_t end = 0;
+};
+
+}
+
+ WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : threadCount(threadCount != 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency())) {}
+
+ void WorkStealingPool::run(std::size_t taskCount,
+    const std::function<void(unsigned worker, std::size_t task)>& body) const {
+    if (taskCount == 0) return;
+    const unsigned workers = static_cast<unsigned>(std::min<std::size_t>(threadCount, taskCount));
+    if (workers == 1) {
+        for (std::size_t task = 0; task < taskCount; ++task) body(0, task);
+        return;
+    }
+
+    std::unique_ptr<TaskRange[]> ranges(new TaskRange[workers]);
+    for (unsigned w = 0; w < workers; ++w) {
+        ranges[w].begin = taskCount * w / workers;
+        ranges[w].end = taskCount * (w + 1) / workers;
+    }
+
+    std::atomic<bool> failed{ false };
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto work = [&](unsigned self) {
+        try {
+            while (!failed) {
+                std::size_t task;
+                {
+                    TaskRange& own = ranges[self];
+                    std::lock_guard<std::mutex> lock(own.mutex);
+                    task = own.begin < own.end ? own.begin++ : taskCount;
+                }
+
+                if (task == taskCount) {
+                    // Steal the back half of the fullest range; stop when nothing is left.
+                    unsigned victim = self;
+                    std::size_t most = 0;
+                    for (unsigned w = 0; w < workers; ++w) {
+                        if (w == self) continue;
+                        std::lock_guard<std::mutex> lock(ranges[w].mutex);
+                        if (ranges[w].end - ranges[w].begin > most) {
+                            most = ranges[w].end - ranges[w].begin;
+                            victim = w;
+                        }
+                    }
+                    if (victim == self) return;
+
+                    std::size_t stolenBegin;
+                    std::size_t stolenEnd;
+                    {
+                        std::lock_guard<std::mutex> lock(ranges[victim].mutex);
+                        const std::size_t remaining = ranges[victim].end - ranges[victim].begin;
+                        if (remaining == 0) continue;
+                        stolenEnd = ranges[victim].end;
+                        stolenBegin = stolenEnd - (remaining + 1) / 2;
+                        ranges[victim].end = stolenBegin;
+                    }
+                    task = stolenBegin;
+                    std::lock_guard<std::mutex> lock(ranges[self].mutex);
+                    ranges[self].begin = stolenBegin + 1;
+                    ranges[self].end = stolenEnd;
+                }
+
+                body(self, task);
+            }
+        }
+        catch (...) {
+            failed = true;
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!error) error = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned w = 1; w < workers; ++w) threads.emplace_back(work, w);
+    work(0);
+    for (std::thread& thread : threads) thread.join();
+    if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+
+/**
+ * @class WorkStealingPool
+ * @brief Runs a numbered set of independent tasks on several threads, balancing by stealing.
+ * @ingroup Core Core Logic
+ *
+ * The task numbers are split into one contiguous range per worker. A worker takes tasks
+ * from the front of its own range. Once its range is empty, it steals the back half of
+ * the largest remaining range. Tasks of very different cost, such as a BFS tree shared by
+ * many queries next to a single short search, therefore do not leave threads idle while
+ * one worker is still busy.
+ *
+ * Threads are started for each run() and joined before it returns. The calling thread
+ * works as worker 0.
+ */
+
+class WorkStealingPool {
+public:
+    /**
+     * @brief Creates a pool.
+     *
+     * @param threadCount Number of workers. If 0, hardware concurrency is used.
+     */
+    explicit WorkStealingPool(unsigned threadCount = 0);
+
+    /**
+     * @brief Returns the number of workers.
+     */
+    unsigned getThreadCount() const { return threadCount; }
+
+    /**
+     * @brief Runs body(worker, task) once for every task in [0, taskCount).
+     *
+     * Worker numbers are below getThreadCount(), so callers can keep one scratch state per
+     * worker. If a task throws, the remaining tasks are abandoned and the first exception
+     * is rethrown once all workers have stopped.
+     *
+     * @param taskCount Number of tasks.
+     * @param body Function called for each task. It must be safe to call concurrently.
+     */
+    void run(std::size_t taskCount, const std::function<void(unsigned worker, std::size_t task)>& body) const;
+
+private:
+    unsigned threadCount; ///< Number of workers, at least 1.
+};
@@ -0,0 +1,77 @@
+#include "DictionaryIndex.h"
+#include "GraphSnapshot.h"
+#include "Solver.h"
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @brief Checks word lookups of solvers that share one dictionary index.
+ *
+ * Usage: solver_lookup_test
+ *
+ * A position in another length's bucket is not a node of a solver's graph, so such words
+ * must be reported as unknown instead of being mistaken for one of its nodes. The move
+ * checks of the play tab are covered on the same dictionary. Every failed check is
+ * printed, and the exit code is 1 if any failed.
+ */
+
+namespace {
+
+int failures = 0;
+
+/**
+ * @brief Records a failed check.
+ */
+void expect(bool passed, const std::string& description) {
+    if (passed) return;
+    std::cerr << "FAILED: " << description << std::endl;
+    ++failures;
+}
+
+/**
+ * @brief Checks one validateMove() result.
+ */
+void expectMove(const Solver& solver, const std::string& current, const std::string& next, Solver::MoveCheck expected) {
+    expect(solver.validateMove(current, next) == expected,
+        "validateMove(" + current + ", " + next + ") on the length " + std::to_string(solver.getGraph().wordLength(0))
+            + " solver");
+}
+
+}
+
+int main() {
+    auto dictionary = std::make_shared<const DictionaryIndex>(std::vector<std::string_view>{
+        "CAT", "COT", "DOG", "DOT", "COLD", "CORD", "CARD", "WARD", "WORD", "WORM" });
+    GraphSnapshot snapshot(dictionary);
+    std::shared_ptr<const Solver> three = snapshot.buildSolver(3);
+    std::shared_ptr<const Solver> four = snapshot.buildSolver(4);
+
+    expect(three->findShortestPath("CAT", "DOG").size() == 4, "CAT to DOG takes three moves");
+    expect(four->findShortestPath("COLD", "WARM").empty(), "WARM is not a dictionary word");
+    expect(four->findShortestPath("CAT", "DOG").empty(), "the length 4 solver rejects length 3 words");
+    expect(!four->isReachable("CAT", "COT"), "the length 4 solver does not reach between length 3 words");
+    expect(!three->isReachable("WORM", "CAT"), "the length 3 solver rejects length 4 words");
+    expect(three->distanceToTarget("CARD", "COT") == -1, "no distance from a word of another length");
+
+    expectMove(*three, "COT", "DOT", Solver::MoveCheck::Legal);
+    expectMove(*four, "CORD", "WORD", Solver::MoveCheck::Legal);
+    expectMove(*three, "CAT", "CAT", Solver::MoveCheck::SameWord);
+    expectMove(*three, "CAT", "DOG", Solver::MoveCheck::NotOneLetter);
+    expectMove(*four, "COLD", "WARD", Solver::MoveCheck::NotOneLetter);
+    expectMove(*three, "CAT", "CUT", Solver::MoveCheck::NotInDictionary);
+    expectMove(*four, "WORM", "WARM", Solver::MoveCheck::NotInDictionary);
+    expectMove(*three, "CUT", "CAT", Solver::MoveCheck::UnknownCurrent);
+    expectMove(*four, "CAT", "COT", Solver::MoveCheck::LengthMismatch);
+    expectMove(*three, "CORD", "CARD", Solver::MoveCheck::LengthMismatch);
+    expectMove(*three, "CAT", "CART", Solver::MoveCheck::LengthMismatch);
+
+    if (failures != 0) {
+        std::cerr << failures << " check(s) failed" << std::endl;
+        return 1;
+    }
+    std::cout << "All checks passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "GraphImage.h"
+#include "HubLabelIndex.h"
+#include <chrono>
+#include <exception>
+#include <iostream>
+#include <string>
+
+/**
+ * @brief Offline compiler turning a text dictionary into a memory-mappable graph image.
+ *
+ * Usage: compile_graph [--hub-labels] <dictionary.txt> [image.wlg]
+ *
+ * If no output path is given, the image is written next to the dictionary with the
+ * extension replaced by ".wlg", which is where the application looks for it. With
+ * --hub-labels, a hub label index is also built and saved next to the image for every
+ * word length, enabling exact distance queries without searching.
+ */
+int main(int argc, char* argv[]) {
+    bool hubLabels = false;
+    std::string dictionaryPath;
+    std::string imagePath;
+    bool validArguments = true;
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        if (argument == "--hub-labels") hubLabels = true;
+        else if (dictionaryPath.empty()) dictionaryPath = argument;
+        else if (imagePath.empty()) imagePath = argument;
+        else validArguments = false;
+    }
+    if (!validArguments || dictionaryPath.empty()) {
+        std::cerr << "Usage: " << argv[0] << " [--hub-labels] <dictionary.txt> [image.wlg]" << std::endl;
+        return 2;
+    }
+
+    if (imagePath.empty()) {
+        std::size_t dot = dictionaryPath.find_last_of('.');
+        std::size_t slash = dictionaryPath.find_last_of("/\\");
+        bool hasExtension = dot != std::string::npos && (slash == std::string::npos || dot > slash);
+        imagePath = (hasExtension ? dictionaryPath.substr(0, dot) : dictionaryPath) + ".wlg";
+    }
+
+    try {
+        auto started = std::chrono::steady_clock::now();
+        GraphImage::compile(dictionaryPath, imagePath);
+        auto compiled = std::chrono::steady_clock::now();
+
+        std::shared_ptr<const GraphImage> image = GraphImage::open(imagePath);
+        std::cout << "Wrote " << imagePath << " in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(compiled - started).count()
+            << " ms" << std::endl;
+        for (std::size_t length : image->getWordLengths()) {
+            CompactGraph graph = image->getGraph(length);
+            std::cout << "  length " << length << ": " << graph.nodeCount() << " words, "
+                << graph.edgeCount() << " edges, " << graph.componentCount() << " components";
+
+            if (hubLabels) {
+                auto labelStarted = std::chrono::steady_clock::now();
+                HubLabelIndex index(graph);
+                index.save(HubLabelIndex::companionPath(imagePath, length));
+                auto labelled = std::chrono::steady_clock::now();
+                std::cout << ", " << index.entryCount() << " label entries in "
+                    << std::chrono::duration_cast<std::chrono::milliseconds>(labelled - labelStarted).count()
+                    << " ms";
+            }
+            std::cout << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,327 @@
+#include "GraphCache.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#if defined(_WIN32)
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+/**
+ * @brief Headless batch solver: answers word ladder queries without the GUI.
+ *
+ * Usage: ladder_cli [--image FILE] [--threads N] [--lengths] [--binary] [--output FILE] [--watch]
+ *                   <dictionary.txt> [queries.txt]
+ *
+ * Queries are read from the file, or from standard input if it is omitted or "-", one
+ * "start target" pair per line. They are solved in chunks, each handed to
+ * Solver::solveBatch() per word length, and the results are written in input order, so
+ * memory stays bounded for any number of queries.
+ *
+ * Text output has one line per query: the number of moves followed by the words of a
+ * shortest ladder, or "unreachable", or "invalid" for lines that are not two words.
+ * With --lengths only the number of moves is printed.
+ *
+ * Binary output (--binary) has one record per query, all integers little-endian: an
+ * int32 move count (-1 unreachable, -2 invalid) and, unless --lengths is given and only
+ * for solved queries, a uint32 word length followed by the words of the ladder,
+ * concatenated without separators.
+ *
+ * With --watch the dictionary file is watched while queries are read: when it changes,
+ * the graphs are rebuilt in the background and later chunks are solved with the new
+ * ones, while the chunk in progress finishes on the graphs it started with. Chunks then
+ * end at the input already buffered, and results are flushed after each chunk, so the
+ * solver can serve a pipe that stays open. Each reload is reported on standard error.
+ *
+ * Throughput and latency percentiles are reported on standard error at the end, with
+ * the reload counters when watching. Rejected queries (lines that are not two words,
+ * words of different lengths or words missing from the dictionary) are counted apart
+ * and, like unreachable ones, are not searched, so only solved queries have latencies.
+ * Queries answered by one shared BFS tree each count the time of the whole tree.
+ */
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr std::size_t ChunkSize = 1 << 16;  ///< Queries read and solved at a time.
+constexpr int Unreachable = -1;
+constexpr int Invalid = -2;
+
+struct Options {
+    std::string dictionaryPath;
+    std::string queriesPath;
+    std::string imagePath;
+    std::string outputPath;
+    unsigned threadCount = 0;
+    bool lengthsOnly = false;
+    bool binary = false;
+    bool watch = false;
+};
+
+struct Totals {
+    std::size_t solved = 0;      ///< Queries answered with a ladder.
+    std::size_t unreachable = 0; ///< Queries of two dictionary words with no ladder between them.
+    std::size_t rejected = 0;    ///< Lines that are not two words, words of different lengths, unknown words.
+};
+
+void appendInt32(std::string& out, std::uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) out.push_back(static_cast<char>((value >> shift) & 0xFF));
+}
+
+/**
+ * @brief Splits a query line into two upper-case words; returns false if it is not two words.
+ */
+bool parseQuery(const std::string& line, std::string& start, std::string& target) {
+    std::istringstream fields(line);
+    std::string extra;
+    if (!(fields >> start >> target) || (fields >> extra)) return false;
+    for (std::string* word : { &start, &target }) {
+        std::transform(word->begin(), word->end(), word->begin(), ::toupper);
+    }
+    return true;
+}
+
+/**
+ * @brief Appends the result record of one query.
+ */
+void appendResult(int moves, const std::vector<std::string>& path, std::size_t wordLength,
+    const Options& options, std::string& out) {
+    if (options.binary) {
+        appendInt32(out, static_cast<std::uint32_t>(moves));
+        if (moves >= 0 && !options.lengthsOnly) {
+            appendInt32(out, static_cast<std::uint32_t>(wordLength));
+            for (const std::string& word : path) out += word;
+        }
+    }
+    else if (moves == Unreachable) {
+        out += "unreachable\n";
+    }
+    else if (moves == Invalid) {
+        out += "invalid\n";
+    }
+    else {
+        out += std::to_string(moves);
+        for (const std::string& word : path) {
+            out += ' ';
+            out += word;
+        }
+        out += '\n';
+    }
+}
+
+/**
+ * @brief Solves one chunk of queries, one Solver::solveBatch() per word length, and
+ *        writes the results in input order.
+ */
+void solveChunk(const std::vector<std::string>& lines, GraphCache& cache, const Options& options,
+    std::ostream& out, std::vector<float>& latencies, Totals& totals) {
+    std::vector<int> moves(lines.size(), Invalid);
+    std::vector<std::vector<std::string>> paths(lines.size());
+    std::vector<std::size_t> wordLengths(lines.size(), 0);
+    std::vector<unsigned char> rejected(lines.size(), 1);
+
+    std::unordered_map<std::size_t, std::vector<std::size_t>> byLength;
+    std::unordered_map<std::size_t, std::vector<Solver::BatchQuery>> queries;
+    Solver::BatchQuery query;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        if (!parseQuery(lines[i], query.start, query.target)) continue;
+        moves[i] = Unreachable;
+        if (query.start.size() != query.target.size()) continue;
+        wordLengths[i] = query.start.size();
+        byLength[query.start.size()].push_back(i);
+        queries[query.start.size()].push_back(query);
+    }
+
+    Solver::BatchOptions batchOptions;
+    batchOptions.threadCount = options.threadCount;
+    batchOptions.withPaths = !options.lengthsOnly;
+    for (const auto& bucket : byLength) {
+        const std::shared_ptr<const Solver> solver = cache.get(bucket.first);
+        const std::vector<Solver::BatchQuery>& batch = queries[bucket.first];
+        std::vector<Solver::BatchResult> results = solver->solveBatch(batch, batchOptions);
+        for (std::size_t k = 0; k < results.size(); ++k) {
+            const std::size_t line = bucket.second[k];
+            moves[line] = results[k].distance;
+            paths[line].swap(results[k].path);
+            // Only searched queries have a latency; the others were turned away by a lookup.
+            if (moves[line] >= 0) {
+                rejected[line] = 0;
+                latencies.push_back(results[k].microseconds);
+            }
+            else {
+                const CompactGraph& graph = solver->getGraph();
+                rejected[line] = !graph.contains(batch[k].start) || !graph.contains(batch[k].target);
+            }
+        }
+    }
+
+    std::string buffer;
+    for (std::size_t i = 0; i < lines.size(); ++i) {
+        appendResult(moves[i], paths[i], wordLengths[i], options, buffer);
+        if (moves[i] >= 0) ++totals.solved;
+        else if (rejected[i]) ++totals.rejected;
+        else ++totals.unreachable;
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+}
+
+float percentile(std::vector<float>& values, double fraction) {
+    if (values.empty()) return 0;
+    std::size_t index = std::min(values.size() - 1, static_cast<std::size_t>(fraction * values.size()));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+bool parseArguments(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string argument = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (argument == "--image" && hasValue) options.imagePath = argv[++i];
+        else if (argument == "--output" && hasValue) options.outputPath = argv[++i];
+        else if (argument == "--threads" && hasValue) options.threadCount = std::strtoul(argv[++i], nullptr, 10);
+        else if (argument == "--lengths") options.lengthsOnly = true;
+        else if (argument == "--binary") options.binary = true;
+        else if (argument == "--watch") options.watch = true;
+        else if (options.dictionaryPath.empty()) options.dictionaryPath = argument;
+        else if (options.queriesPath.empty()) options.queriesPath = argument;
+        else return false;
+    }
+    return !options.dictionaryPath.empty();
+}
+
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--image FILE] [--threads N] [--lengths] [--binary]"
+            " [--output FILE] [--watch] <dictionary.txt> [queries.txt]" << std::endl;
+        return 2;
+    }
+    if (options.threadCount == 0) options.threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    std::ios::sync_with_stdio(false);
+    std::ifstream queryFile;
+    if (!options.queriesPath.empty() && options.queriesPath != "-") {
+        queryFile.open(options.queriesPath);
+        if (!queryFile.is_open()) {
+            std::cerr << "Error: Could not open file " << options.queriesPath << std::endl;
+            return 1;
+        }
+    }
+    std::istream& in = queryFile.is_open() ? queryFile : std::cin;
+
+    std::ofstream outputFile;
+    if (!options.outputPath.empty()) {
+        outputFile.open(options.outputPath, std::ios::binary | std::ios::trunc);
+        if (!outputFile.is_open()) {
+            std::cerr << "Error: Could not open file " << options.outputPath << std::endl;
+            return 1;
+        }
+    }
+#if defined(_WIN32)
+    else if (options.binary) {
+        _setmode(_fileno(stdout), _O_BINARY);
+    }
+#endif
+    std::ostream& out = outputFile.is_open() ? outputFile : std::cout;
+
+    try {
+        // The CLI loads each length once, so nothing is ever evicted.
+        GraphCache cache(options.dictionaryPath, options.imagePath, std::numeric_limits<std::size_t>::max());
+        if (options.watch) {
+            cache.watch(GraphCache::DefaultWatchInterval, [&cache](std::shared_ptr<const GraphSnapshot> next) {
+                if (!next) {
+                    std::cerr << "Dictionary reload failed; still using the previous version" << std::endl;
+                    return;
+                }
+                const GraphCache::ReloadStats stats = cache.getReloadStats();
+                std::cerr << std::fixed << std::setprecision(1) << "Dictionary reloaded (version "
+                    << next->getVersion() << ") in " << stats.lastReloadMilliseconds << " ms, "
+                    << stats.lastSolvedDuringReload << " queries solved meanwhile" << std::endl;
+            });
+        }
+        std::vector<float> latencies;
+        Totals totals;
+        Clock::duration loadTime{};
+        Clock::duration solveTime{};
+        bool firstChunk = true;
+
+        std::vector<std::string> lines;
+        lines.reserve(ChunkSize);
+        std::string line;
+        while (true) {
+            lines.clear();
+            // A watching solver answers what has arrived instead of waiting for a full chunk.
+            while (lines.size() < ChunkSize
+                && (!options.watch || lines.empty() || in.rdbuf()->in_avail() > 0)
+                && std::getline(in, line)) {
+                if (!line.empty() && line.back() == '\r') line.pop_back();
+                if (!line.empty()) lines.push_back(line);
+            }
+            if (lines.empty()) break;
+
+            if (firstChunk) {
+                // Build the graphs of the lengths seen so far up front, so their
+                // construction is reported separately instead of as query latency.
+                std::vector<std::size_t> lengths;
+                std::string start;
+                std::string target;
+                for (const std::string& query : lines) {
+                    if (parseQuery(query, start, target)
+                        && std::find(lengths.begin(), lengths.end(), start.size()) == lengths.end()) {
+                        lengths.push_back(start.size());
+                    }
+                }
+                auto started = Clock::now();
+                cache.prebuild(lengths, options.threadCount);
+                cache.wait();
+                loadTime = Clock::now() - started;
+                firstChunk = false;
+            }
+
+            auto started = Clock::now();
+            solveChunk(lines, cache, options, out, latencies, totals);
+            solveTime += Clock::now() - started;
+            if (options.watch) out.flush();
+        }
+        out.flush();
+        cache.stopWatching();
+
+        const std::size_t queries = totals.solved + totals.unreachable + totals.rejected;
+        const double seconds = std::chrono::duration<double>(solveTime).count();
+        std::cerr << std::fixed << std::setprecision(1)
+            << "Graphs loaded in " << std::chrono::duration<double, std::milli>(loadTime).count() << " ms\n"
+            << "Answered " << queries << " queries (" << totals.solved << " solved, " << totals.unreachable
+            << " unreachable, " << totals.rejected << " rejected) in " << std::setprecision(3) << seconds << " s, "
+            << std::setprecision(0) << (seconds > 0 ? queries / seconds : 0.0) << " queries/s on "
+            << options.threadCount << " threads\n" << std::setprecision(2)
+            << "Latency of solved queries (us): p50 " << percentile(latencies, 0.50) << ", p90 " << percentile(latencies, 0.90)
+            << ", p99 " << percentile(latencies, 0.99) << ", p99.9 " << percentile(latencies, 0.999)
+            << ", max " << percentile(latencies, 1.0) << std::endl;
+        if (options.watch) {
+            const GraphCache::ReloadStats stats = cache.getReloadStats();
+            std::cerr << "Reloads: " << stats.reloads << " (" << stats.failedReloads << " failed), last in "
+                << std::setprecision(1) << stats.lastReloadMilliseconds << " ms, "
+                << stats.solvedDuringReloads << " queries solved during reloads" << std::endl;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}